@@ -38,4 +38,8 @@ struct st_net_server
 
 typedef struct st_net_server NET_SERVER;
 
+void net_grow_write_buffer(struct st_net *net);
+void net_shrink_write_buffer(struct st_net *net, size_t length);
+my_bool net_flush_reply(struct st_net *net);
+
 #endif
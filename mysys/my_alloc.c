@@ -429,6 +429,88 @@ void free_root(MEM_ROOT *root, myf MyFlags)
   DBUG_VOID_RETURN;
 }
 
+/*
+  Deallocate everything used by alloc_root, but keep some blocks for reuse
+
+  SYNOPSIS
+    free_root_keep()
+      root		Memory root
+      keep_size		How many bytes of blocks, in addition to the
+			preallocated block, to keep in the free list
+
+  NOTES
+    Works like free_root(root, MYF(MY_KEEP_PREALLOC)), but a root that
+    is cleared after every statement does not have to malloc and free
+    the same blocks again for every statement that needs more memory
+    than the preallocated block.
+*/
+
+void free_root_keep(MEM_ROOT *root, size_t keep_size)
+{
+#if !(defined(HAVE_valgrind) && defined(EXTRA_DEBUG))
+  reg1 USED_MEM *next,*old;
+  USED_MEM *kept= 0;
+  DBUG_ENTER("free_root_keep");
+  DBUG_PRINT("enter",("root: %p  name: %s  keep: %zu", root, root_name(root),
+                      keep_size));
+
+  if (!keep_size)
+  {
+    free_root(root, MYF(MY_KEEP_PREALLOC));
+    DBUG_VOID_RETURN;
+  }
+
+  for (next=root->used; next ;)
+  {
+    old=next; next= next->next;
+    if (old == root->pre_alloc)
+      continue;
+    if (old->size <= keep_size)
+    {
+      keep_size-= old->size;
+      old->next= kept;
+      kept= old;
+    }
+    else
+      my_free(old);
+  }
+  for (next=root->free ; next ;)
+  {
+    old=next; next= next->next;
+    if (old == root->pre_alloc)
+      continue;
+    if (old->size <= keep_size)
+    {
+      keep_size-= old->size;
+      old->next= kept;
+      kept= old;
+    }
+    else
+      my_free(old);
+  }
+  for (next= kept; next; next= next->next)
+  {
+    next->left= next->size - ALIGN_SIZE(sizeof(USED_MEM));
+    TRASH_MEM(next);
+  }
+  root->used= 0;
+  root->free= kept;
+  if (root->pre_alloc)
+  {
+    /* The preallocated block is always the first to be used */
+    root->free= root->pre_alloc;
+    root->free->left= root->pre_alloc->size-ALIGN_SIZE(sizeof(USED_MEM));
+    TRASH_MEM(root->pre_alloc);
+    root->free->next= kept;
+  }
+  root->block_num= 4;
+  root->first_block_usage= 0;
+  DBUG_VOID_RETURN;
+#else
+  free_root(root, MYF(MY_KEEP_PREALLOC));
+#endif
+}
+
 /*
   Find block that contains an object and set the pre_alloc to it
 */
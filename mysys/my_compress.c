@@ -159,6 +159,88 @@ uchar *my_compress_alloc(const uchar *packet, size_t *len, size_t *complen)
 }
 
 
+/*
+  Compress data into a caller supplied buffer, reusing a deflate context
+
+  SYNOPSIS
+    my_compress_ctx()
+    ctx		in/out: deflate context. Allocated on first use and
+		reused by later calls. Free it with my_compress_ctx_free()
+    dest	Where to store the compressed data
+    destLen	in: size of 'dest', out: length of the compressed data
+    source	Data to compress
+    sourceLen	Length of data to compress
+
+  NOTES
+    Every call produces a complete zlib stream, so the result can be
+    read with my_uncompress(). Reusing the context saves allocating and
+    initializing the deflate state, which my_compress() does for every
+    packet, and compressing into 'dest' saves the copies of the data.
+
+  RETURN
+    1   Not compressed: the result does not fit into 'dest' or error
+    0   ok.  In this case 'destLen' contains the size of the compressed data
+*/
+
+my_bool my_compress_ctx(void **ctx, uchar *dest, size_t *destLen,
+                        const uchar *source, size_t sourceLen)
+{
+  z_stream *stream= (z_stream*) *ctx;
+  DBUG_ENTER("my_compress_ctx");
+
+  if ((size_t) (uInt) *destLen != *destLen ||
+      (size_t) (uInt) sourceLen != sourceLen)
+    DBUG_RETURN(1);
+
+  if (!stream)
+  {
+    if (!(stream= (z_stream*) my_malloc(key_memory_my_compress_alloc,
+                                        sizeof(*stream), MYF(MY_WME))))
+      DBUG_RETURN(1);
+    stream->zalloc= (alloc_func)my_az_allocator;
+    stream->zfree= (free_func)my_az_free;
+    stream->opaque= (voidpf)0;
+    if (deflateInit(stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+      my_free(stream);
+      DBUG_RETURN(1);
+    }
+    *ctx= stream;
+  }
+  else if (deflateReset(stream) != Z_OK)
+    DBUG_RETURN(1);
+
+  stream->next_in= (Bytef*) source;
+  stream->avail_in= (uInt) sourceLen;
+  stream->next_out= (Bytef*) dest;
+  stream->avail_out= (uInt) *destLen;
+
+  if (deflate(stream, Z_FINISH) != Z_STREAM_END)
+  {
+    DBUG_PRINT("note",("Packet did not get shorter; Not compressed"));
+    DBUG_RETURN(1);
+  }
+  *destLen= stream->total_out;
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Free a context allocated by my_compress_ctx()
+*/
+
+void my_compress_ctx_free(void **ctx)
+{
+  z_stream *stream= (z_stream*) *ctx;
+  if (stream)
+  {
+    deflateEnd(stream);
+    my_free(stream);
+    *ctx= 0;
+  }
+}
+
+
 /*
   Uncompress packet
 
@@ -1,3 +1,5 @@
+#include "ref10/ge.h"
+
 int crypto_sign_keypair(
   unsigned char *pk,
   unsigned char *pw, unsigned long long pwlen
@@ -11,3 +13,17 @@ int crypto_sign_open(
   unsigned char *sm, unsigned long long smlen,
   const unsigned char *pk
 );
+
+/*
+  crypto_sign_open() split in two: the public key part, that can be
+  computed once per key, and the signature check that uses it.
+*/
+#define CRYPTO_SIGN_PRECOMP_SIZE 8
+int crypto_sign_open_precomp(
+  ge_cached *Ai,
+  const unsigned char *pk
+);
+int crypto_sign_open_cached(
+  unsigned char *sm, unsigned long long smlen,
+  const unsigned char *pk, const ge_cached *Ai
+);
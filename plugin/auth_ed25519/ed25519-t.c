@@ -32,9 +32,10 @@ int main()
 
   uchar nonce[NONCE_BYTES];
   uchar reply[NONCE_BYTES+CRYPTO_BYTES];
+  ge_cached Ai[CRYPTO_SIGN_PRECOMP_SIZE];
   int r;
 
-  plan(4);
+  plan(7);
 
   crypto_sign_keypair(pk, USTRING_WITH_LEN("foobar"));
   ok(!memcmp(pk, foobar_pk, CRYPTO_PUBLICKEYBYTES), "foobar pk");
@@ -51,5 +52,17 @@ int main()
   r= crypto_sign_open(reply, sizeof(reply), pk);
   ok(r, "bad nonce");
 
+  r= crypto_sign_open_precomp(Ai, pk);
+  ok(!r, "precomputed pk");
+
+  crypto_sign(reply, nonce, sizeof(nonce), USTRING_WITH_LEN("foobar"));
+  r= crypto_sign_open_cached(reply, sizeof(reply), pk, Ai);
+  ok(!r, "good nonce, precomputed pk");
+
+  crypto_sign(reply, nonce, sizeof(nonce), USTRING_WITH_LEN("foobar"));
+  reply[CRYPTO_BYTES + 10]='B';
+  r= crypto_sign_open_cached(reply, sizeof(reply), pk, Ai);
+  ok(r, "bad nonce, precomputed pk");
+
   return exit_status();
 }
@@ -70,6 +70,8 @@ typedef struct {
 #define ge_sub crypto_sign_ed25519_ref10_ge_sub
 #define ge_scalarmult_base crypto_sign_ed25519_ref10_ge_scalarmult_base
 #define ge_double_scalarmult_vartime crypto_sign_ed25519_ref10_ge_double_scalarmult_vartime
+#define ge_double_scalarmult_precomp crypto_sign_ed25519_ref10_ge_double_scalarmult_precomp
+#define ge_double_scalarmult_cached crypto_sign_ed25519_ref10_ge_double_scalarmult_cached
 
 extern void ge_tobytes(unsigned char *,const ge_p2 *);
 extern void ge_p3_tobytes(unsigned char *,const ge_p3 *);
@@ -91,5 +93,7 @@ extern void ge_add(ge_p1p1 *,const ge_p3 *,const ge_cached *);
 extern void ge_sub(ge_p1p1 *,const ge_p3 *,const ge_cached *);
 extern void ge_scalarmult_base(ge_p3 *,const unsigned char *);
 extern void ge_double_scalarmult_vartime(ge_p2 *,const unsigned char *,const ge_p3 *,const unsigned char *);
+extern void ge_double_scalarmult_precomp(ge_cached *,const ge_p3 *);
+extern void ge_double_scalarmult_cached(ge_p2 *,const unsigned char *,const ge_cached *,const unsigned char *);
 
 #endif
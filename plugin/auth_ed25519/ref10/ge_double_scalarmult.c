@@ -37,24 +37,15 @@ static ge_precomp Bi[8] = {
 } ;
 
 /*
-r = a * A + b * B
-where a = a[0]+256*a[1]+...+256^31 a[31].
-and b = b[0]+256*b[1]+...+256^31 b[31].
-B is the Ed25519 base point (x,4/5) with x positive.
+Ai = A,3A,5A,7A,9A,11A,13A,15A
+as used by ge_double_scalarmult_cached()
 */
 
-void ge_double_scalarmult_vartime(ge_p2 *r,const unsigned char *a,const ge_p3 *A,const unsigned char *b)
+void ge_double_scalarmult_precomp(ge_cached *Ai,const ge_p3 *A)
 {
-  signed char aslide[256];
-  signed char bslide[256];
-  ge_cached Ai[8]; /* A,3A,5A,7A,9A,11A,13A,15A */
   ge_p1p1 t;
   ge_p3 u;
   ge_p3 A2;
-  int i;
-
-  slide(aslide,a);
-  slide(bslide,b);
 
   ge_p3_to_cached(&Ai[0],A);
   ge_p3_dbl(&t,A); ge_p1p1_to_p3(&A2,&t);
@@ -65,6 +56,26 @@ void ge_double_scalarmult_vartime(ge_p2 *r,const unsigned char *a,const ge_p3 *A
   ge_add(&t,&A2,&Ai[4]); ge_p1p1_to_p3(&u,&t); ge_p3_to_cached(&Ai[5],&u);
   ge_add(&t,&A2,&Ai[5]); ge_p1p1_to_p3(&u,&t); ge_p3_to_cached(&Ai[6],&u);
   ge_add(&t,&A2,&Ai[6]); ge_p1p1_to_p3(&u,&t); ge_p3_to_cached(&Ai[7],&u);
+}
+
+/*
+r = a * A + b * B
+where a = a[0]+256*a[1]+...+256^31 a[31].
+and b = b[0]+256*b[1]+...+256^31 b[31].
+B is the Ed25519 base point (x,4/5) with x positive.
+and Ai = A,3A,...,15A from ge_double_scalarmult_precomp().
+*/
+
+void ge_double_scalarmult_cached(ge_p2 *r,const unsigned char *a,const ge_cached *Ai,const unsigned char *b)
+{
+  signed char aslide[256];
+  signed char bslide[256];
+  ge_p1p1 t;
+  ge_p3 u;
+  int i;
+
+  slide(aslide,a);
+  slide(bslide,b);
 
   ge_p2_0(r);
 
@@ -94,3 +105,11 @@ void ge_double_scalarmult_vartime(ge_p2 *r,const unsigned char *a,const ge_p3 *A
     ge_p1p1_to_p2(r,&t);
   }
 }
+
+void ge_double_scalarmult_vartime(ge_p2 *r,const unsigned char *a,const ge_p3 *A,const unsigned char *b)
+{
+  ge_cached Ai[8]; /* A,3A,5A,7A,9A,11A,13A,15A */
+
+  ge_double_scalarmult_precomp(Ai,A);
+  ge_double_scalarmult_cached(r,a,Ai,b);
+}
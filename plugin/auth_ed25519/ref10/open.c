@@ -5,20 +5,30 @@
 #include "ge.h"
 #include "sc.h"
 
-int crypto_sign_open(
-  unsigned char *sm, unsigned long long smlen,
+int crypto_sign_open_precomp(
+  ge_cached *Ai,
   const unsigned char *pk
 )
+{
+  ge_p3 A;
+
+  if (ge_frombytes_negate_vartime(&A,pk) != 0) return -1;
+  ge_double_scalarmult_precomp(Ai,&A);
+  return 0;
+}
+
+int crypto_sign_open_cached(
+  unsigned char *sm, unsigned long long smlen,
+  const unsigned char *pk, const ge_cached *Ai
+)
 {
   unsigned char scopy[32];
   unsigned char h[64];
   unsigned char rcheck[32];
-  ge_p3 A;
   ge_p2 R;
 
   if (smlen < 64) goto badsig;
   if (sm[63] & 224) goto badsig;
-  if (ge_frombytes_negate_vartime(&A,pk) != 0) goto badsig;
 
   memmove(scopy,sm + 32,32);
 
@@ -26,7 +36,7 @@ int crypto_sign_open(
   crypto_hash_sha512(h,sm,smlen);
   sc_reduce(h);
 
-  ge_double_scalarmult_vartime(&R,h,&A,scopy);
+  ge_double_scalarmult_cached(&R,h,Ai,scopy);
   ge_tobytes(rcheck,&R);
   if (crypto_verify_32(rcheck,sm) == 0)
     return 0;
@@ -34,3 +44,14 @@ int crypto_sign_open(
 badsig:
   return -1;
 }
+
+int crypto_sign_open(
+  unsigned char *sm, unsigned long long smlen,
+  const unsigned char *pk
+)
+{
+  ge_cached Ai[CRYPTO_SIGN_PRECOMP_SIZE];
+
+  if (crypto_sign_open_precomp(Ai,pk) != 0) return -1;
+  return crypto_sign_open_cached(sm,smlen,pk,Ai);
+}
@@ -14,6 +14,8 @@
    along with this program; if not, write to the Free Software
    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA */
 
+#include <my_global.h>
+#include <my_pthread.h>
 #include <mysql/plugin_auth.h>
 #include <mysqld_error.h>
 #include "common.h"
@@ -32,11 +34,57 @@
 
 static int loaded= 0;
 
+/*
+  Precomputed public keys of the recently authenticated users.
+
+  Decoding the public key and computing its multiples is a noticeable
+  part of the signature check, and it is the same for every login of
+  the user. The cache is keyed by the public key itself, so a new
+  password (ALTER USER, SET PASSWORD, GRANT) never finds a stale entry.
+  Collisions simply replace the entry in the slot.
+*/
+#define KEY_CACHE_SIZE 64
+
+struct key_cache_entry
+{
+  unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+  ge_cached Ai[CRYPTO_SIGN_PRECOMP_SIZE];
+  int used;
+};
+
+static struct key_cache_entry key_cache[KEY_CACHE_SIZE];
+static pthread_mutex_t key_cache_lock;
+
+static int get_key(ge_cached *Ai, const unsigned char *pk)
+{
+  struct key_cache_entry *entry= key_cache + pk[0] % KEY_CACHE_SIZE;
+
+  pthread_mutex_lock(&key_cache_lock);
+  if (entry->used && !memcmp(entry->pk, pk, CRYPTO_PUBLICKEYBYTES))
+  {
+    memcpy(Ai, entry->Ai, sizeof(entry->Ai));
+    pthread_mutex_unlock(&key_cache_lock);
+    return 0;
+  }
+  pthread_mutex_unlock(&key_cache_lock);
+
+  if (crypto_sign_open_precomp(Ai, pk))
+    return 1;
+
+  pthread_mutex_lock(&key_cache_lock);
+  memcpy(entry->pk, pk, CRYPTO_PUBLICKEYBYTES);
+  memcpy(entry->Ai, Ai, sizeof(entry->Ai));
+  entry->used= 1;
+  pthread_mutex_unlock(&key_cache_lock);
+  return 0;
+}
+
 static int auth(MYSQL_PLUGIN_VIO *vio, MYSQL_SERVER_AUTH_INFO *info)
 {
   int pkt_len;
   unsigned long nonce[CRYPTO_LONGS + NONCE_LONGS];
   unsigned char *pkt, *reply= (unsigned char*)nonce;
+  ge_cached Ai[CRYPTO_SIGN_PRECOMP_SIZE];
 
   info->password_used= PASSWORD_USED_YES;
 
@@ -53,8 +101,12 @@ static int auth(MYSQL_PLUGIN_VIO *vio, MYSQL_SERVER_AUTH_INFO *info)
     return CR_AUTH_HANDSHAKE;
   memcpy(reply, pkt, CRYPTO_BYTES);
 
-  if (crypto_sign_open(reply, CRYPTO_BYTES + NONCE_BYTES,
-                       (unsigned char*)info->auth_string))
+  if (info->auth_string_length != CRYPTO_PUBLICKEYBYTES ||
+      get_key(Ai, (unsigned char*)info->auth_string))
+    return CR_ERROR;
+
+  if (crypto_sign_open_cached(reply, CRYPTO_BYTES + NONCE_BYTES,
+                              (unsigned char*)info->auth_string, Ai))
     return CR_ERROR;
 
   return CR_OK;
@@ -103,6 +155,7 @@ static struct st_mysql_auth info =
 
 static int init(void *p __attribute__((unused)))
 {
+  pthread_mutex_init(&key_cache_lock, NULL);
   loaded= 1;
   return 0;
 }
@@ -110,6 +163,8 @@ static int init(void *p __attribute__((unused)))
 static int deinit(void *p __attribute__((unused)))
 {
   loaded= 0;
+  pthread_mutex_destroy(&key_cache_lock);
+  memset(key_cache, 0, sizeof(key_cache));
   return 0;
 }
 
@@ -41,7 +41,7 @@ template<typename Element_type, typename Key_type>
 class Bounded_queue
 {
 public:
-  Bounded_queue()
+  Bounded_queue() : m_tailmaker(NULL), m_key_buff(NULL)
   {
     memset(&m_queue, 0, sizeof(m_queue));
   }
@@ -49,6 +49,7 @@ class Bounded_queue
   ~Bounded_queue()
   {
     delete_queue(&m_queue);
+    my_free(m_key_buff);
   }
 
   /**
@@ -87,6 +88,10 @@ class Bounded_queue
     @param keymaker       Function which generates keys for elements.
     @param sort_param     Sort parameters.
     @param sort_keys      Array of pointers to keys to sort.
+    @param tailmaker      If not NULL, keymaker makes only the first
+                          compare_length bytes of the key and tailmaker
+                          the data stored after them. The tail is then
+                          only made for elements that enter the queue.
 
     @retval 0 OK, 1 Could not allocate memory.
 
@@ -95,7 +100,7 @@ class Bounded_queue
   int init(ha_rows max_elements, bool max_at_top,
            compare_function compare, size_t compare_length,
            keymaker_function keymaker, Sort_param *sort_param,
-           Key_type **sort_keys);
+           Key_type **sort_keys, keymaker_function tailmaker= NULL);
 
   /**
     Pushes an element on the queue.
@@ -140,6 +145,8 @@ class Bounded_queue
   Key_type         **m_sort_keys;
   size_t             m_compare_length;
   keymaker_function  m_keymaker;
+  keymaker_function  m_tailmaker;
+  Key_type          *m_key_buff;      // Key of the pushed element, if tailmaker
   Sort_param        *m_sort_param;
   st_queue           m_queue;
 };
@@ -152,17 +159,24 @@ int Bounded_queue<Element_type, Key_type>::init(ha_rows max_elements,
                                                 size_t compare_length,
                                                 keymaker_function keymaker,
                                                 Sort_param *sort_param,
-                                                Key_type **sort_keys)
+                                                Key_type **sort_keys,
+                                                keymaker_function tailmaker)
 {
   DBUG_ASSERT(sort_keys != NULL);
 
   m_sort_keys=      sort_keys;
   m_compare_length= compare_length;
   m_keymaker=       keymaker;
+  m_tailmaker=      tailmaker;
   m_sort_param=     sort_param;
   // init_queue() takes an uint, and also does (max_elements + 1)
   if (max_elements >= (UINT_MAX - 1))
     return 1;
+  if (tailmaker &&
+      !(m_key_buff= (Key_type*) my_malloc(PSI_NOT_INSTRUMENTED,
+                                          compare_length,
+                                          MYF(MY_WME | MY_THREAD_SPECIFIC))))
+    return 1;
   if (compare == NULL)
     compare=
       reinterpret_cast<compare_function>(get_ptr_compare(compare_length));
@@ -182,12 +196,34 @@ void Bounded_queue<Element_type, Key_type>::push(Element_type *element)
   {
     // Replace top element with new key, and re-order the queue.
     Key_type **pq_top= reinterpret_cast<Key_type **>(queue_top(&m_queue));
-    (void)(*m_keymaker)(m_sort_param, *pq_top, element, false);
+    if (m_tailmaker)
+    {
+      /*
+        An element whose key sorts after the top would be dropped right
+        away. Check the key first, so that the tail is not made for the
+        (usually most) elements that are discarded. Ties still replace
+        the top, like for queues without a tail, so that the same rows
+        are kept among equal keys.
+      */
+      (void)(*m_keymaker)(m_sort_param, m_key_buff, element, false);
+      if (m_queue.compare(m_queue.first_cmp_arg,
+                          reinterpret_cast<uchar*>(pq_top),
+                          reinterpret_cast<uchar*>(&m_key_buff)) *
+          m_queue.max_at_top > 0)
+        return;
+      memcpy(*pq_top, m_key_buff, m_compare_length);
+      (void)(*m_tailmaker)(m_sort_param, *pq_top, element, false);
+    }
+    else
+      (void)(*m_keymaker)(m_sort_param, *pq_top, element, false);
     queue_replace_top(&m_queue);
   } else {
     // Insert new key into the queue.
     (*m_keymaker)(m_sort_param, m_sort_keys[m_queue.elements],
                   element, false);
+    if (m_tailmaker)
+      (*m_tailmaker)(m_sort_param, m_sort_keys[m_queue.elements],
+                     element, false);
     queue_insert(&m_queue,
                  reinterpret_cast<uchar*>(&m_sort_keys[m_queue.elements]));
   }
@@ -52,6 +52,11 @@ static uint make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
                          bool using_packed_sortkeys= false);
 static uint make_sortkey(Sort_param *param, uchar *to);
 static uint make_packed_sortkey(Sort_param *param, uchar *to);
+static uint make_sortkey_tail(Sort_param *param, uchar *to, uchar *ref_pos);
+static uint make_pq_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
+                            bool using_packed_sortkeys);
+static uint make_pq_addons(Sort_param *param, uchar *to, uchar *ref_pos,
+                           bool using_packed_sortkeys);
 
 static void register_used_fields(Sort_param *param);
 static bool save_index(Sort_param *param, uint count,
@@ -284,7 +289,14 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
       point in doing lazy initialization).
     */
     sort->init_record_pointers();
-    if (pq.init(param.max_rows,
+    if (param.using_addon_fields() ?
+        pq.init(param.max_rows,
+                true,                           // max_at_top
+                NULL,                           // compare_function
+                compare_length,
+                &make_pq_sortkey, &param, sort->get_sort_keys(),
+                &make_pq_addons) :
+        pq.init(param.max_rows,
                 true,                           // max_at_top
                 NULL,                           // compare_function
                 compare_length,
@@ -1347,6 +1359,46 @@ static uint make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
   to+= using_packed_sortkeys ?
        make_packed_sortkey(param, to) :
        make_sortkey(param, to);
+  to+= make_sortkey_tail(param, to, ref_pos);
+  return static_cast<uint>(to - orig_to);
+}
+
+
+/*
+  Keymakers for the priority queue when addon fields are used.
+
+  The sort key and the addon fields are made separately, so that
+  Bounded_queue::push() makes the addon fields only for the rows that
+  enter the queue. With a small LIMIT over many rows, most rows are
+  rejected by their sort key alone.
+*/
+
+static uint make_pq_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
+                            bool using_packed_sortkeys)
+{
+  DBUG_ASSERT(!using_packed_sortkeys);
+  return make_sortkey(param, to);
+}
+
+
+static uint make_pq_addons(Sort_param *param, uchar *to, uchar *ref_pos,
+                           bool using_packed_sortkeys)
+{
+  DBUG_ASSERT(!using_packed_sortkeys);
+  return make_sortkey_tail(param, to + param->sort_length, ref_pos);
+}
+
+
+/**
+  Append the addon fields, or the row reference if there are none, to
+  a sort key.
+
+  @retval length of the bytes written
+*/
+
+static uint make_sortkey_tail(Sort_param *param, uchar *to, uchar *ref_pos)
+{
+  uchar *orig_to= to;
 
   if (param->using_addon_fields())
   {
@@ -3110,6 +3110,76 @@ int handler::ha_rnd_pos(uchar *buf, uchar *pos)
   DBUG_RETURN(result);
 }
 
+int handler::ha_sample_init(double fraction)
+{
+  int result;
+  DBUG_ENTER("handler::ha_sample_init");
+  DBUG_ASSERT(inited == NONE);
+  DBUG_ASSERT(fraction > 0 && fraction <= 1);
+  sample_fraction= fraction;
+  inited= (result= sample_init(fraction)) ? NONE : RND;
+  end_range= NULL;
+  DBUG_RETURN(result);
+}
+
+int handler::ha_sample_next(uchar *buf)
+{
+  int result;
+  DBUG_ENTER("handler::ha_sample_next");
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE ||
+              m_lock_type != F_UNLCK);
+  DBUG_ASSERT(inited == RND);
+
+  do
+  {
+    TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, result,
+      { result= sample_next(buf); })
+    if (result != HA_ERR_RECORD_DELETED)
+      break;
+    status_var_increment(table->in_use->status_var.ha_read_rnd_deleted_count);
+  } while (!table->in_use->check_killed(1));
+
+  if (result == HA_ERR_RECORD_DELETED)
+    result= HA_ERR_ABORTED_BY_USER;
+  else
+  {
+    if (!result)
+    {
+      update_rows_read();
+      if (table->vfield && buf == table->record[0])
+        table->update_virtual_fields(this, VCOL_UPDATE_FOR_READ);
+    }
+    increment_statistics(&SSV::ha_read_rnd_next_count);
+  }
+
+  table->status=result ? STATUS_NOT_FOUND: 0;
+  DBUG_RETURN(result);
+}
+
+int handler::ha_sample_end()
+{
+  DBUG_ENTER("handler::ha_sample_end");
+  DBUG_ASSERT(inited == RND);
+  inited= NONE;
+  end_range= NULL;
+  DBUG_RETURN(sample_end());
+}
+
+int handler::sample_next(uchar *buf)
+{
+  int result;
+  THD *thd= table->in_use;
+  while (!(result= rnd_next(buf)) || result == HA_ERR_RECORD_DELETED)
+  {
+    if (!result &&
+        (sample_fraction >= 1.0 || thd_rnd(thd) <= sample_fraction))
+      break;
+    if (thd->check_killed(1))
+      return HA_ERR_ABORTED_BY_USER;
+  }
+  return result;
+}
+
 int handler::ha_index_read_map(uchar *buf, const uchar *key,
                                       key_part_map keypart_map,
                                       enum ha_rkey_function find_flag)
@@ -3188,6 +3188,12 @@ class handler :public Sql_alloc
   */
   uint auto_inc_intervals_count;
 
+  /**
+    Probability for a row to be returned by a sample scan, see
+    ha_sample_init().
+  */
+  double sample_fraction;
+
   /**
     Instrumented table associated with this handler.
     This member should be set to NULL when no instrumentation is in place,
@@ -3303,6 +3309,7 @@ class handler :public Sql_alloc
     pushed_rowid_filter(NULL),
     rowid_filter_is_active(0),
     auto_inc_intervals_count(0),
+    sample_fraction(1.0),
     m_psi(NULL),
     m_psi_batch_mode(PSI_BATCH_MODE_NONE),
     m_psi_numrows(0),
@@ -3944,6 +3951,15 @@ class handler :public Sql_alloc
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
 
+  /**
+    Sample scan: return a random subset of the table rows, each row with
+    the probability 'fraction', independently of the others. Used when
+    collecting engine independent statistics.
+  */
+  int ha_sample_init(double fraction) __attribute__ ((warn_unused_result));
+  int ha_sample_next(uchar *buf);
+  int ha_sample_end();
+
   /**
     The following 3 function is only needed for tables that may be
     internal temporary tables during joins.
@@ -3959,6 +3975,25 @@ class handler :public Sql_alloc
                                    const key_range *max_key,
                                    page_range *res)
     { return (ha_rows) 10; }
+  /**
+    Estimate the number of rows in each of a batch of ranges of one index.
+
+    The ranges come in index order. The default implementation calls
+    records_in_range() for each range; an engine can override it to share
+    work between the ranges.
+
+    @param inx       Index number
+    @param n_ranges  Number of ranges
+    @param min_keys  Start of each range, NULL if the range has none
+    @param max_keys  End of each range, NULL if the range has none
+    @param rows      OUT: estimate for each range. Estimates following
+                     an HA_POS_ERROR one are undefined.
+    @param pages     IN/OUT: position of each range, see records_in_range()
+  */
+  virtual void records_in_ranges(uint inx, uint n_ranges,
+                                 const key_range **min_keys,
+                                 const key_range **max_keys,
+                                 ha_rows *rows, page_range *pages);
   /*
     If HA_PRIMARY_KEY_REQUIRED_FOR_POSITION is set, then it sets ref
     (reference to the row, aka position, with the primary key given in
@@ -4748,6 +4783,15 @@ class handler :public Sql_alloc
   */
   virtual int rnd_init(bool scan)= 0;
   virtual int rnd_end() { return 0; }
+  /**
+    The default sample scan reads all rows with rnd_next() and drops the
+    ones that are not in the sample. Engines that can find the n-th row
+    without reading the rows before it should skip them instead.
+    sample_next() may return HA_ERR_RECORD_DELETED.
+  */
+  virtual int sample_init(double fraction) { return rnd_init(TRUE); }
+  virtual int sample_next(uchar *buf);
+  virtual int sample_end() { return rnd_end(); }
   virtual int write_row(const uchar *buf __attribute__((unused)))
   {
     return HA_ERR_WRONG_COMMAND;
@@ -3647,26 +3647,59 @@ static int cmp_decimal(void *cmp_arg, my_decimal *a, my_decimal *b)
 }
 
 
-bool in_vector::find(Item *item)
-{
-  uchar *result=get_value(item);
-  if (!result || !used_count)
-    return false;				// Null value
+/*
+  Binary search for a value in the sorted elements of an in_vector
+
+  The comparison is a template parameter, so that a known comparison
+  function can be inlined into the loop.
+*/
 
+template <class Compare>
+static inline bool find_sorted(const in_vector *vector, const uchar *value,
+                               Compare cmp)
+{
+  const uchar *base= (const uchar*) vector->base;
+  uint size= vector->size;
   uint start,end;
-  start=0; end=used_count-1;
+  start=0; end=vector->used_count-1;
   while (start != end)
   {
     uint mid=(start+end+1)/2;
     int res;
-    if ((res=(*compare)(collation, base+mid*size, result)) == 0)
+    if ((res=cmp(base+mid*size, value)) == 0)
       return true;
     if (res < 0)
       start=mid;
     else
       end=mid-1;
   }
-  return ((*compare)(collation, base+start*size, result) == 0);
+  return (cmp(base+start*size, value) == 0);
+}
+
+
+bool in_vector::find(Item *item)
+{
+  uchar *result=get_value(item);
+  if (!result || !used_count)
+    return false;				// Null value
+
+  /*
+    Integer and temporal lists are the most common ones, call their
+    comparison directly instead of through the function pointer.
+  */
+  if (compare == (qsort2_cmp) cmp_longlong)
+    return find_sorted(this, result,
+                       [](const uchar *a, const uchar *b)
+                       {
+                         return cmp_longlong(NULL,
+                                             (in_longlong::packed_longlong*) a,
+                                             (in_longlong::packed_longlong*) b);
+                       });
+  return find_sorted(this, result,
+                     [this](const uchar *a, const uchar *b)
+                     {
+                       return (*compare)(collation, a, b);
+                     });
 }
 
 in_string::in_string(THD *thd, uint elements, qsort2_cmp cmp_func,
@@ -3716,6 +3716,7 @@ void subselect_uniquesubquery_engine::cleanup()
       has been already dropped by close_thread_tables(), while we here are
       called from cleanup_items()
   */
+  int_value_set= NULL;
   DBUG_VOID_RETURN;
 }
 
@@ -4175,6 +4176,18 @@ int subselect_uniquesubquery_engine::exec()
       DBUG_RETURN(scan_table());
   }
 
+  if (int_value_set)
+  {
+    /*
+      The values are compared as integers of the same signedness, so
+      the condition that compares them need not be checked.
+    */
+    longlong value= tab->ref.items[0]->val_int();
+    in_subs->value= int_value_set->find(value);
+    empty_result_set= !in_subs->value;
+    DBUG_RETURN(thd->is_error());
+  }
+
   if (copy_ref_key(true))
   {
     /* We know that there will be no rows even if we scan. */
@@ -4255,6 +4268,149 @@ int subselect_uniquesubquery_engine::index_lookup()
 
 
 
+static bool is_plain_int_type(enum_field_types type)
+{
+  switch (type) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    return TRUE;
+  default:
+    return FALSE;
+  }
+}
+
+
+static int cmp_int_values(const void *a, const void *b)
+{
+  longlong x= *(const longlong*) a, y= *(const longlong*) b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+
+/*
+  Read the non-NULL values of the only column of a materialized table
+
+  @param thd           Thread handle
+  @param table         The materialized table
+  @param unsigned_arg  TRUE if the values are unsigned
+
+  @retval FALSE  OK
+  @retval TRUE   Error (out of memory, or the table could not be read)
+*/
+
+bool Subq_int_value_set::build(THD *thd, TABLE *table, bool unsigned_arg)
+{
+  Field *field= table->field[0];
+  ha_rows rows= table->file->stats.records;
+  uint n= 0;
+  int error;
+  DBUG_ENTER("Subq_int_value_set::build");
+
+  unsigned_values= unsigned_arg;
+  if (!(values= (longlong*) thd->alloc(sizeof(longlong) * (size_t) rows)))
+    DBUG_RETURN(TRUE);
+  table->file->ha_index_or_rnd_end();
+  if (table->file->ha_rnd_init(1))
+    DBUG_RETURN(TRUE);
+  while (!(error= table->file->ha_rnd_next(table->record[0])))
+  {
+    if (field->is_null())
+      continue;
+    if (n == rows)
+    {
+      /* The statistics were not exact */
+      error= HA_ERR_OUT_OF_MEM;
+      break;
+    }
+    values[n++]= sort_key(field->val_int());
+  }
+  table->file->ha_rnd_end();
+  if (error != HA_ERR_END_OF_FILE)
+    DBUG_RETURN(TRUE);
+
+  elements= n;
+  if (!n)
+    DBUG_RETURN(FALSE);
+  my_qsort(values, n, sizeof(longlong), cmp_int_values);
+  min_value= values[0];
+  max_value= values[n - 1];
+
+  /* Use a bitmap if it takes less than 8 bytes per value */
+  ulonglong range= (ulonglong) max_value - (ulonglong) min_value;
+  if (range < (ulonglong) n * 64 &&
+      (bitmap= (uchar*) thd->calloc((size_t) (range / 8 + 1))))
+  {
+    for (uint i= 0; i < n; i++)
+    {
+      ulonglong bit= (ulonglong) values[i] - (ulonglong) min_value;
+      bitmap[bit / 8]|= (uchar) (1 << (bit % 8));
+    }
+    values= NULL;
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+bool Subq_int_value_set::find(longlong value) const
+{
+  longlong key= sort_key(value);
+  if (!elements || key < min_value || key > max_value)
+    return FALSE;
+  if (bitmap)
+  {
+    ulonglong bit= (ulonglong) key - (ulonglong) min_value;
+    return MY_TEST(bitmap[bit / 8] & (1 << (bit % 8)));
+  }
+  uint lo= 0, hi= elements;
+  while (lo < hi)
+  {
+    uint mid= lo + (hi - lo) / 2;
+    if (values[mid] < key)
+      lo= mid + 1;
+    else
+      hi= mid;
+  }
+  return lo < elements && values[lo] == key;
+}
+
+
+/*
+  Check whether the materialized values can be looked up in memory
+
+  @details
+    When the temporary table has one integer column, the left expression
+    is an integer of the same signedness and the values fit into the
+    memory allowed for in-memory temporary tables, the values are read
+    into a Subq_int_value_set. exec() then looks the left expression up
+    there without any handler calls. A failure to build the set is not an
+    error: the index of the table is used instead.
+*/
+
+void subselect_uniquesubquery_engine::init_int_value_set()
+{
+  TABLE *table= tab->table;
+  Field *field= table->field[0];
+  Item *left= tab->ref.items[0];
+  DBUG_ENTER("subselect_uniquesubquery_engine::init_int_value_set");
+
+  if (table->s->fields != 1 || tab->ref.key_parts != 1 ||
+      !is_plain_int_type(field->real_type()) ||
+      !is_plain_int_type(left->field_type()) ||
+      MY_TEST(field->flags & UNSIGNED_FLAG) != left->unsigned_flag ||
+      table->file->stats.records * sizeof(longlong) >
+      thd->variables.tmp_memory_table_size)
+    DBUG_VOID_RETURN;
+
+  Subq_int_value_set *set= new (thd->mem_root) Subq_int_value_set();
+  if (set && !set->build(thd, table, left->unsigned_flag))
+    int_value_set= set;
+  DBUG_VOID_RETURN;
+}
+
+
 subselect_uniquesubquery_engine::~subselect_uniquesubquery_engine()
 {
   /* Tell handler we don't need the index anymore */
@@ -5688,6 +5844,8 @@ int subselect_hash_sj_engine::exec()
 
   if (pm_engine)
     lookup_engine= pm_engine;
+  else if (strategy == COMPLETE_MATCH)
+    ((subselect_uniquesubquery_engine*) lookup_engine)->init_int_value_set();
   item_in->change_engine(lookup_engine);
 
 err:
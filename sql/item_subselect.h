@@ -949,6 +949,37 @@ class subselect_union_engine: public subselect_engine
 struct st_join_table;
 
 
+/*
+  The integer values of a materialized subquery with one integer column.
+
+  The values are kept in a bitmap when they are dense enough, otherwise in
+  a sorted array, so that they can be looked up without the handler calls
+  of the temporary table. NULL values are not kept.
+*/
+
+class Subq_int_value_set :public Sql_alloc
+{
+  /* Sorted values, NULL when the bitmap is used */
+  longlong *values;
+  uint elements;
+  /* Bit (v - min_value) is set for each value v */
+  uchar *bitmap;
+  longlong min_value, max_value;
+  bool unsigned_values;
+
+  /* The value mapped so that it is ordered as a signed number */
+  longlong sort_key(longlong value) const
+  {
+    return unsigned_values ?
+           (longlong) ((ulonglong) value ^ (1ULL << 63)) : value;
+  }
+public:
+  Subq_int_value_set() :values(NULL), elements(0), bitmap(NULL) {}
+  bool build(THD *thd, TABLE *table, bool unsigned_arg);
+  bool find(longlong value) const;
+};
+
+
 /*
   A subquery execution engine that evaluates the subquery by doing one index
   lookup in a unique index.
@@ -976,12 +1007,18 @@ class subselect_uniquesubquery_engine: public subselect_engine
     expression is NULL.
   */
   bool empty_result_set;
+  /*
+    If not NULL, the values of the materialized table that are looked up
+    instead of the index, see init_int_value_set()
+  */
+  Subq_int_value_set *int_value_set;
 public:
 
   // constructor can assign THD because it will be called after JOIN::prepare
   subselect_uniquesubquery_engine(THD *thd_arg, st_join_table *tab_arg,
 				  Item_in_subselect *subs, Item *where)
-    :subselect_engine(subs, 0), tab(tab_arg), cond(where)
+    :subselect_engine(subs, 0), tab(tab_arg), cond(where),
+     int_value_set(NULL)
   { DBUG_ASSERT(subs); }
   ~subselect_uniquesubquery_engine();
   void cleanup();
@@ -1000,6 +1037,7 @@ class subselect_uniquesubquery_engine: public subselect_engine
   int index_lookup(); /* TIMOUR: this method needs refactoring. */
   int scan_table();
   bool copy_ref_key(bool skip_constants);
+  void init_int_value_set();
   bool no_rows() { return empty_result_set; }
   virtual enum_engine_type engine_type() { return UNIQUESUBQUERY_ENGINE; }
 };
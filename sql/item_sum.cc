@@ -1944,6 +1944,137 @@ void Item_sum_count::cleanup()
 }
 
 
+/*
+  APPROX_COUNT_DISTINCT
+*/
+
+/**
+  Mix the bits of a 64 bit value (the MurmurHash3 finalizer), so that
+  both the bucket number and the rank bits of the sketch are uniform.
+*/
+
+static inline ulonglong hll_mix(ulonglong h)
+{
+  h^= h >> 33;
+  h*= 0xff51afd7ed558ccdULL;
+  h^= h >> 33;
+  h*= 0xc4ceb9fe1a85ec53ULL;
+  h^= h >> 33;
+  return h;
+}
+
+
+/**
+  Hash the current value of the argument.
+
+  Strings are hashed with their collation, so that values equal for
+  COUNT(DISTINCT) land in the same register.
+*/
+
+ulonglong Item_sum_approx_count_distinct::arg_hash()
+{
+  switch (args[0]->cmp_type()) {
+  case INT_RESULT:
+    return hll_mix((ulonglong) args[0]->val_int());
+  case REAL_RESULT:
+  {
+    double nr= args[0]->val_real();
+    ulonglong bits;
+    if (nr == 0.0)
+      nr= 0.0;                                  // -0.0 == 0.0
+    memcpy(&bits, &nr, sizeof(bits));
+    return hll_mix(bits);
+  }
+  default:
+  {
+    StringBuffer<MAX_FIELD_WIDTH> tmp;
+    String *res= args[0]->val_str(&tmp);
+    ulong nr1= 1, nr2= 4;
+    if (!res)
+      return 0;
+    res->charset()->hash_sort((const uchar *) res->ptr(), res->length(),
+                              &nr1, &nr2);
+    return hll_mix((ulonglong) nr1);
+  }
+  }
+}
+
+
+bool Item_sum_approx_count_distinct::setup(THD *thd)
+{
+  DBUG_ENTER("Item_sum_approx_count_distinct::setup");
+  if (!registers &&
+      !(registers= (uchar *) thd->calloc(register_count)))
+    DBUG_RETURN(TRUE);
+  DBUG_RETURN(FALSE);
+}
+
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD* thd)
+{
+  return new (thd->mem_root) Item_sum_approx_count_distinct(thd, this);
+}
+
+
+void Item_sum_approx_count_distinct::clear()
+{
+  if (registers)
+    bzero(registers, register_count);
+}
+
+
+bool Item_sum_approx_count_distinct::add()
+{
+  DBUG_ASSERT(registers);
+  ulonglong hash= arg_hash();
+  if (args[0]->null_value)
+    return 0;
+  /*
+    The top bits select the register, the register keeps the maximum
+    position of the first 1 bit in the rest of the hash. The extra low
+    bit bounds the rank by 64 - precision + 1.
+  */
+  uint idx= (uint) (hash >> (64 - precision));
+  ulonglong rest= (hash << precision) | (1ULL << (precision - 1));
+  uchar rank= (uchar) (64 - my_bit_log2_uint64(rest));
+  if (rank > registers[idx])
+    registers[idx]= rank;
+  return 0;
+}
+
+
+longlong Item_sum_approx_count_distinct::val_int()
+{
+  DBUG_ASSERT(fixed == 1);
+  if (!registers)
+    return 0;
+
+  const double m= (double) register_count;
+  double sum= 0.0;
+  uint zeros= 0;
+  for (uint i= 0; i < register_count; i++)
+  {
+    sum+= ldexp(1.0, -(int) registers[i]);
+    if (!registers[i])
+      zeros++;
+  }
+  double estimate= 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+  /* Small range correction: linear counting over the empty registers */
+  if (zeros && estimate <= 2.5 * m)
+    estimate= m * log(m / zeros);
+  return (longlong) (estimate + 0.5);
+}
+
+
+void Item_sum_approx_count_distinct::cleanup()
+{
+  DBUG_ENTER("Item_sum_approx_count_distinct::cleanup");
+  registers= NULL;
+  Item_sum_int::cleanup();
+  DBUG_VOID_RETURN;
+}
+
+
 /*
   Average
 */
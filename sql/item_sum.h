@@ -356,7 +356,7 @@ class Item_sum :public Item_func_or_sum
     CUME_DIST_FUNC, NTILE_FUNC, FIRST_VALUE_FUNC, LAST_VALUE_FUNC,
     NTH_VALUE_FUNC, LEAD_FUNC, LAG_FUNC, PERCENTILE_CONT_FUNC,
     PERCENTILE_DISC_FUNC, SP_AGGREGATE_FUNC, JSON_ARRAYAGG_FUNC,
-    JSON_OBJECTAGG_FUNC
+    JSON_OBJECTAGG_FUNC, APPROX_COUNT_DISTINCT_FUNC
   };
 
   Item **ref_by; /* pointer to a ref to the object used to register it */
@@ -430,6 +430,7 @@ class Item_sum :public Item_func_or_sum
     case UDF_SUM_FUNC:
     case GROUP_CONCAT_FUNC:
     case JSON_ARRAYAGG_FUNC:
+    case APPROX_COUNT_DISTINCT_FUNC:
       return true;
     default:
       return false;
@@ -919,6 +920,53 @@ class Item_sum_count :public Item_sum_int
 };
 
 
+/**
+  APPROX_COUNT_DISTINCT(expr)
+
+  Estimates the number of distinct non-NULL values of expr with a
+  HyperLogLog sketch. Unlike COUNT(DISTINCT) it needs no Unique tree and
+  no disk, only register_count bytes per group. Small cardinalities are
+  estimated with linear counting and are practically exact.
+*/
+
+class Item_sum_approx_count_distinct :public Item_sum_int
+{
+  static const uint precision= 14;
+  static const uint register_count= 1U << precision;
+
+  /* One register per sketch bucket, allocated in setup() */
+  uchar *registers;
+
+  ulonglong arg_hash();
+
+public:
+  Item_sum_approx_count_distinct(THD *thd, Item *item_par):
+    Item_sum_int(thd, item_par), registers(NULL)
+  {
+    /* The sketch does not fit into a tmp table field, group by sorting */
+    quick_group= 0;
+  }
+  Item_sum_approx_count_distinct(THD *thd,
+                                 Item_sum_approx_count_distinct *item):
+    Item_sum_int(thd, item), registers(NULL)
+  {}
+  enum Sumfunctype sum_func () const { return APPROX_COUNT_DISTINCT_FUNC; }
+  const Type_handler *type_handler() const { return &type_handler_slonglong; }
+  bool setup(THD *thd);
+  void clear();
+  bool add();
+  void cleanup();
+  longlong val_int();
+  void reset_field() { DBUG_ASSERT(0); }        // not used
+  void update_field() { DBUG_ASSERT(0); }       // not used
+  void no_rows_in_result() { clear(); }
+  const char *func_name() const { return "approx_count_distinct("; }
+  Item *copy_or_same(THD* thd);
+  Item *get_copy(THD *thd)
+  { return get_item_copy<Item_sum_approx_count_distinct>(thd, this); }
+};
+
+
 class Item_sum_avg :public Item_sum_sum
 {
 public:
@@ -25,12 +25,202 @@
  * Default MRR implementation (MRR to non-MRR converter)
  ***************************************************************************/
 
+/**
+  The default implementation of records_in_ranges(): one records_in_range()
+  call per range.
+*/
+
+void handler::records_in_ranges(uint inx, uint n_ranges,
+                                const key_range **min_keys,
+                                const key_range **max_keys,
+                                ha_rows *rows, page_range *pages)
+{
+  for (uint i= 0; i < n_ranges; i++)
+  {
+    if ((rows[i]= records_in_range(inx, min_keys[i], max_keys[i],
+                                   &pages[i])) == HA_POS_ERROR)
+      break;
+  }
+}
+
+
+/*
+  Number of ranges that multi_range_read_info_const() passes to one
+  records_in_ranges() call
+*/
+#define MRR_DIVE_BATCH 16
+
+/**
+  Count of the index blocks read by a sequence of ranges, built from
+  the estimates and the positions that records_in_range() returns.
+*/
+
+class Range_blocks_count
+{
+public:
+  /*
+     Counter of blocks that contain range edges for those ranges
+     for which records_in_range() is called
+  */
+  ulonglong edge_blocks_cnt;
+ /*
+   Counter of blocks that contain index tuples for those ranges
+   for which records_in_range() is called
+  */
+  ulonglong range_blocks_cnt;
+  /*
+    The position of the block containing the last record of the previous range
+    for which the info about range position is provided
+  */
+  ulonglong prev_range_last_block;
+  /* The counter of records the staring from prev_range_last_block */
+  ulonglong prev_range_last_block_records;
+  /*
+    The counter of of single point ranges that we succeded to assign
+    to some blocks
+  */
+  ulonglong assigned_single_point_ranges;
+  /*
+    Counter of single point ranges for which records_in_range in not
+    called and that are encountered between two ranges without such property
+    For example, let's have a subsequence of ranges
+    R1,r1,....rk,R2
+    where r1,...,rk are single point ranges for which records_in_range is
+    called while R1 and R2 are not such ranges.
+    Then single_point_ranges_delta will count ranges r1,...,rk.
+  */
+  ulonglong unassigned_single_point_ranges;
+  uint avg_block_records;
+  ulong block_size;
+
+  Range_blocks_count(uint avg_block_records_arg, ulong block_size_arg)
+    :edge_blocks_cnt(0), range_blocks_cnt(0),
+     prev_range_last_block(UNUSED_PAGE_NO), prev_range_last_block_records(0),
+     assigned_single_point_ranges(0), unassigned_single_point_ranges(0),
+     avg_block_records(avg_block_records_arg), block_size(block_size_arg)
+  {}
+
+  /**
+    Account for a range estimated by records_in_range()
+
+    @param rows                 Estimate for the range
+    @param pages                Position of the range
+    @param single_point_ranges  Number of single point ranges that precede
+                                the range in the sequence
+  */
+  void add_range(ha_rows rows, const page_range &pages,
+                 ulonglong single_point_ranges);
+};
+
+
+void Range_blocks_count::add_range(ha_rows rows, const page_range &pages,
+                                   ulonglong single_point_ranges)
+{
+  if (pages.first_page == UNUSED_PAGE_NO)
+  {
+    /*
+      The engine does not provide info on the range position.
+      Place the range in a new block. Note that in this case
+      any new range will be placed in a new block.
+    */
+    ulonglong additional_blocks= ((MY_MAX(rows,1) - 1) / avg_block_records +
+                                  1);
+    edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
+    range_blocks_cnt+= additional_blocks;
+  }
+  else
+  {
+    /* The info on the range position is provided */
+    if (pages.first_page == prev_range_last_block)
+    {
+      /*
+        The new range starts in the same block that the last range
+        for which the position of the range was provided.
+      */
+      /*
+        First add records of single point ranges that can be placed
+        between these two ranges.
+      */
+      prev_range_last_block_records+= (single_point_ranges -
+                                       assigned_single_point_ranges);
+      assigned_single_point_ranges= single_point_ranges;
+      if (pages.first_page == pages.last_page)
+      {
+        /*
+          All records of the current range are in the same block
+          Note that the prev_range_last_block_records can be much larger
+          than max_records_in_block as the rows can be compressed!
+        */
+        prev_range_last_block_records+= rows;
+        DBUG_ASSERT(prev_range_last_block_records < block_size);
+      }
+      else
+      {
+        /*
+          The current range spans more than one block
+
+          Place part of the range records in 'prev_range_last_block'
+          and the remaining records in additional blocks.
+
+          We don't know where the first key was positioned in the
+          block, so we assume the range started in the middle of the
+          block.
+
+          Note that prev_range_last_block_records > avg_block_records
+          can be true in case of compressed rows.
+        */
+        ha_rows rem_rows= rows;
+
+        if (avg_block_records > prev_range_last_block_records)
+        {
+          ha_rows space_left_in_prev_block=
+            (avg_block_records - prev_range_last_block_records)/2;
+          rem_rows= 0;
+          if (rows > space_left_in_prev_block)
+            rem_rows= rows - space_left_in_prev_block;
+        }
+        /* Calculate how many additional blocks we need for rem_rows */
+        ulonglong additional_blocks= ((MY_MAX(rem_rows, 1) - 1) /
+                                      avg_block_records + 1);
+        edge_blocks_cnt++;
+        range_blocks_cnt+= additional_blocks;
+        prev_range_last_block= pages.last_page;
+        /* There is at least one row on last page */
+        prev_range_last_block_records= 1;
+      }
+    }
+    else
+    {
+      /*
+        The new range does not start in the same block that the last range
+        for which the position of the range was provided.
+        Note that rows may be 0!
+      */
+      ulonglong additional_blocks= ((MY_MAX(rows, 1) - 1) /
+                                    avg_block_records + 1);
+      edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
+      range_blocks_cnt+= additional_blocks;
+      unassigned_single_point_ranges+= (single_point_ranges -
+                                        assigned_single_point_ranges);
+      assigned_single_point_ranges= single_point_ranges;
+      prev_range_last_block= pages.last_page;
+      /* There is at least one row on last page */
+      prev_range_last_block_records= 1;
+    }
+  }
+}
+
+
 /**
   Get cost and other information about MRR scan over a known list of ranges
 
   Calculate estimated cost and other information about an MRR scan for given
   sequence of ranges.
 
+  The ranges that need records_in_range() are estimated in batches of
+  MRR_DIVE_BATCH ranges with records_in_ranges(), so that the engine can
+  share the work between neighbouring ranges.
+
   @param keyno           Index number
   @param seq             Range sequence to be traversed
   @param seq_init_param  First parameter for seq->init()
@@ -69,50 +259,44 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
   ha_rows max_rows= stats.records;
   THD *thd= table->in_use;
   ulonglong io_blocks;
-
-  /*
-     Counter of blocks that contain range edges for those ranges
-     for which records_in_range() is called
-  */
-  ulonglong edge_blocks_cnt= 0;
- /*
-   Counter of blocks that contain index tuples for those ranges
-   for which records_in_range() is called
-  */
-  ulonglong range_blocks_cnt= 0;
-  /*
-    The position of the block containing the last record of the previous range
-    for which the info about range position is provided
-  */
-  ulonglong prev_range_last_block= UNUSED_PAGE_NO;
-  /* The counter of records the staring from prev_range_last_block */
-  ulonglong prev_range_last_block_records= 0;
   /*
     The counter of single point ranges.
     (For single point ranges we do not call records_in_range())
   */
   ulonglong single_point_ranges= 0;
+
+  /* Ranges collected for the next records_in_ranges() call */
+  key_range dive_min[MRR_DIVE_BATCH], dive_max[MRR_DIVE_BATCH];
+  const key_range *dive_min_endp[MRR_DIVE_BATCH];
+  const key_range *dive_max_endp[MRR_DIVE_BATCH];
+  ha_rows dive_rows[MRR_DIVE_BATCH];
+  page_range dive_pages[MRR_DIVE_BATCH];
+  /* Value of single_point_ranges when the range was collected */
+  ulonglong dive_single_points[MRR_DIVE_BATCH];
+  uint n_dives= 0;
   /*
-    The counter of of single point ranges that we succeded to assign
-    to some blocks
+    The range sequence may reuse its key buffers, so the keys of the
+    collected ranges are copied here: two keys per range.
   */
-  ulonglong assigned_single_point_ranges= 0;
+  uchar *dive_key_buff= NULL;
   /*
-    Counter of single point ranges for which records_in_range in not
-    called and that are encountered between two ranges without such property
-    For example, let's have a subsequence of ranges
-    R1,r1,....rk,R2
-    where r1,...,rk are single point ranges for which records_in_range is
-    called while R1 and R2 are not such ranges.
-    Then single_point_ranges_delta will count ranges r1,...,rk.
+    With extended keys the ranges can also cover the primary key parts
+    that are appended to the key, so KEY::key_length is not enough.
   */
-  ulonglong unassigned_single_point_ranges= 0;
+  uint key_length= 0;
+  {
+    KEY *key_info= table->key_info + keyno;
+    uint n_key_parts= table->actual_n_key_parts(key_info);
+    for (uint part= 0; part < n_key_parts; part++)
+      key_length+= key_info->key_part[part].store_length;
+  }
 
   uint len= table->key_info[keyno].key_length + table->file->ref_length;
   if (table->file->is_clustering_key(keyno))
     len= table->s->stored_rec_length;
   /* Assume block is 75 % full */
   uint avg_block_records= ((uint) (stats.block_size*3/4))/len + 1;
+  Range_blocks_count blocks(avg_block_records, stats.block_size);
   uint limit= thd->variables.eq_range_index_dive_limit;
   bool use_statistics_for_eq_range= eq_ranges_exceeds_limit(seq,
                                                             seq_init_param,
@@ -123,159 +307,107 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
   *bufsz= 0;
 
   seq_it= seq->init(seq_init_param, n_ranges, *flags);
-  while (!seq->next(seq_it, &range))
+  for (bool end_of_seq= false; !end_of_seq; )
   {
-    ha_rows rows;
+    if (!(end_of_seq= seq->next(seq_it, &range)))
+    {
+      if (unlikely(thd->killed != 0))
+        DBUG_RETURN(HA_POS_ERROR);
+
+      n_ranges++;
+      key_range *min_endp, *max_endp;
+      if (range.range_flag & GEOM_FLAG)
+      {
+        /* In this case tmp_min_flag contains the handler-read-function */
+        range.start_key.flag= (ha_rkey_function) (range.range_flag ^ GEOM_FLAG);
+        min_endp= &range.start_key;
+        max_endp= NULL;
+      }
+      else
+      {
+        min_endp= range.start_key.length? &range.start_key : NULL;
+        max_endp= range.end_key.length? &range.end_key : NULL;
+      }
+      int keyparts_used= my_count_bits(range.start_key.keypart_map);
 
-    if (unlikely(thd->killed != 0))
-      DBUG_RETURN(HA_POS_ERROR);
+      if ((range.range_flag & UNIQUE_RANGE) &&
+          !(range.range_flag & NULL_RANGE))
+      {
+        /*
+          In this case we do not call records_in_range() and as a result
+          do not get any info on the edge blocks for this range. However if
+          it happens that the range for which we have such info uses the same
+          block for its first record as the last range for which such info is
+          provided uses for its last record then this range can be assigned
+          later to one of the blocks used by other ranges.
+
+          Note that we don't have to increment edge_blocks_cnt or
+          range_blocks_cnt here.
+        */
+        single_point_ranges++;
+        total_rows++;
+        continue;
+      }
+      if (use_statistics_for_eq_range &&
+          !(range.range_flag & NULL_RANGE) &&
+          (range.range_flag & EQ_RANGE) &&
+          table->key_info[keyno].actual_rec_per_key(keyparts_used - 1) > 0.5)
+      {
+        ha_rows rows= ((ha_rows) table->key_info[keyno].
+                       actual_rec_per_key(keyparts_used-1));
+        blocks.range_blocks_cnt+= ((MY_MAX(rows, 1) - 1) /
+                                   avg_block_records + 1);
+        total_rows+= rows;
+        continue;
+      }
 
-    n_ranges++;
-    key_range *min_endp, *max_endp;
-    if (range.range_flag & GEOM_FLAG)
-    {
-      /* In this case tmp_min_flag contains the handler-read-function */
-      range.start_key.flag= (ha_rkey_function) (range.range_flag ^ GEOM_FLAG);
-      min_endp= &range.start_key;
-      max_endp= NULL;
-    }
-    else
-    {
-      min_endp= range.start_key.length? &range.start_key : NULL;
-      max_endp= range.end_key.length? &range.end_key : NULL;
+      /* Collect the range for records_in_ranges() */
+      if (!dive_key_buff &&
+          !(dive_key_buff= (uchar*) thd->alloc(2 * MRR_DIVE_BATCH *
+                                               key_length)))
+        DBUG_RETURN(HA_POS_ERROR);
+      uchar *key_buff= dive_key_buff + 2 * n_dives * key_length;
+      dive_min_endp[n_dives]= dive_max_endp[n_dives]= NULL;
+      if (min_endp)
+      {
+        DBUG_ASSERT(min_endp->length <= key_length);
+        dive_min[n_dives]= *min_endp;
+        memcpy(key_buff, min_endp->key, min_endp->length);
+        dive_min[n_dives].key= key_buff;
+        dive_min_endp[n_dives]= &dive_min[n_dives];
+      }
+      if (max_endp)
+      {
+        DBUG_ASSERT(max_endp->length <= key_length);
+        dive_max[n_dives]= *max_endp;
+        memcpy(key_buff + key_length, max_endp->key, max_endp->length);
+        dive_max[n_dives].key= key_buff + key_length;
+        dive_max_endp[n_dives]= &dive_max[n_dives];
+      }
+      dive_pages[n_dives]= unused_page_range;
+      dive_single_points[n_dives]= single_point_ranges;
+      if (++n_dives < MRR_DIVE_BATCH)
+        continue;
     }
-    int keyparts_used= my_count_bits(range.start_key.keypart_map);
+    if (!n_dives)
+      continue;
 
-    if ((range.range_flag & UNIQUE_RANGE) && !(range.range_flag & NULL_RANGE))
-    {
-      rows= 1;
-      /*
-        In this case we do not call records_in_range() and as a result
-        do not get any info on the edge blocks for this range. However if it
-        happens that the range for which we have such info uses the same block
-        for its first record as the last range for which such info is
-        provided uses for its last record then this range can be assigned
-        later to one of the blocks used by other ranges.
-
-        Note that we don't have to increment edge_blocks_cnt or
-        range_blocks_cnt here.
-      */
-      single_point_ranges++;
-    }
-    else if (use_statistics_for_eq_range &&
-             !(range.range_flag & NULL_RANGE) &&
-             (range.range_flag & EQ_RANGE) &&
-             table->key_info[keyno].actual_rec_per_key(keyparts_used - 1) > 0.5)
+    records_in_ranges(keyno, n_dives, dive_min_endp, dive_max_endp,
+                      dive_rows, dive_pages);
+    for (uint i= 0; i < n_dives; i++)
     {
-      rows= ((ha_rows) table->key_info[keyno].
-             actual_rec_per_key(keyparts_used-1));
-      range_blocks_cnt+= ((MY_MAX(rows, 1) - 1) / avg_block_records + 1);
-    }
-    else
-    {
-      page_range pages= unused_page_range;
-      if ((rows= this->records_in_range(keyno, min_endp, max_endp, &pages)) ==
-          HA_POS_ERROR)
+      if (dive_rows[i] == HA_POS_ERROR)
       {
         /* Can't scan one range => can't do MRR scan at all */
         total_rows= HA_POS_ERROR;
         break;
       }
-      if (pages.first_page == UNUSED_PAGE_NO)
-      {
-        /*
-          The engine does not provide info on the range position.
-          Place the range in a new block. Note that in this case
-          any new range will be placed in a new block.
-	*/
-        ulonglong additional_blocks= ((MY_MAX(rows,1) - 1) / avg_block_records +
-                                      1);
-        edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
-        range_blocks_cnt+= additional_blocks;
-      }
-      else
-      {
-        /* The info on the range position is provided */
-        if (pages.first_page == prev_range_last_block)
-	{
-          /*
-            The new range starts in the same block that the last range
-            for which the position of the range was provided.
-	  */
-          /*
-            First add records of single point ranges that can be placed
-            between these two ranges.
-	  */
-          prev_range_last_block_records+= (single_point_ranges -
-                                           assigned_single_point_ranges);
-          assigned_single_point_ranges= single_point_ranges;
-          if (pages.first_page == pages.last_page)
-	  {
-            /*
-              All records of the current range are in the same block
-              Note that the prev_range_last_block_records can be much larger
-              than max_records_in_block as the rows can be compressed!
-            */
-            prev_range_last_block_records+= rows;
-            DBUG_ASSERT(prev_range_last_block_records <
-                        stats.block_size);
-          }
-          else
-	  {
-            /*
-              The current range spans more than one block
-
-              Place part of the range records in 'prev_range_last_block'
-              and the remaining records in additional blocks.
-
-              We don't know where the first key was positioned in the
-              block, so we assume the range started in the middle of the
-              block.
-
-              Note that prev_range_last_block_records > avg_block_records
-              can be true in case of compressed rows.
-            */
-            ha_rows rem_rows= rows;
-
-            if (avg_block_records > prev_range_last_block_records)
-            {
-              ha_rows space_left_in_prev_block=
-                (avg_block_records - prev_range_last_block_records)/2;
-              rem_rows= 0;
-              if (rows > space_left_in_prev_block)
-                rem_rows= rows - space_left_in_prev_block;
-            }
-            /* Calculate how many additional blocks we need for rem_rows */
-            ulonglong additional_blocks= ((MY_MAX(rem_rows, 1) - 1) /
-                                          avg_block_records + 1);
-            edge_blocks_cnt++;
-            range_blocks_cnt+= additional_blocks;
-            prev_range_last_block= pages.last_page;
-            /* There is at least one row on last page */
-            prev_range_last_block_records= 1;
-          }
-        }
-        else
-	{
-          /*
-            The new range does not start in the same block that the last range
-            for which the position of the range was provided.
-            Note that rows may be 0!
-	  */
-          ulonglong additional_blocks= ((MY_MAX(rows, 1) - 1) /
-                                        avg_block_records + 1);
-          edge_blocks_cnt+= additional_blocks == 1 ? 1 : 2;
-          range_blocks_cnt+= additional_blocks;
-          unassigned_single_point_ranges+= (single_point_ranges -
-                                            assigned_single_point_ranges);
-          assigned_single_point_ranges= single_point_ranges;
-          prev_range_last_block= pages.last_page;
-          /* There is at least one row on last page */
-          prev_range_last_block_records= 1;
-        }
-      }
+      blocks.add_range(dive_rows[i], dive_pages[i], dive_single_points[i]);
+      total_rows+= dive_rows[i];
     }
-    total_rows+= rows;
+    n_dives= 0;
+    if (total_rows == HA_POS_ERROR)
+      break;
   }
   /*
     Count the number of io_blocks that where not yet read and thus not cached.
@@ -290,9 +422,10 @@ handler::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
     Better to assume we have done a records_in_range() for the equal
     range and it's also cached.
   */
-  io_blocks= (range_blocks_cnt - edge_blocks_cnt);
-  unassigned_single_point_ranges+= (single_point_ranges -
-                                    assigned_single_point_ranges);
+  io_blocks= (blocks.range_blocks_cnt - blocks.edge_blocks_cnt);
+  ulonglong unassigned_single_point_ranges=
+    blocks.unassigned_single_point_ranges +
+    (single_point_ranges - blocks.assigned_single_point_ranges);
 
   if (total_rows != HA_POS_ERROR)
   {
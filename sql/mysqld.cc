@@ -7095,6 +7095,9 @@ SHOW_VAR status_vars[]= {
   {"Column_decompressions",    (char*) offsetof(STATUS_VAR, column_decompressions), SHOW_LONG_STATUS},
   {"Com",                      (char*) com_status_vars, SHOW_ARRAY},
   {"Compression",              (char*) &show_net_compression, SHOW_SIMPLE_FUNC},
+  {"Compression_input_bytes",  (char*) offsetof(STATUS_VAR, compression_input_bytes), SHOW_LONGLONG_STATUS},
+  {"Compression_output_bytes", (char*) offsetof(STATUS_VAR, compression_output_bytes), SHOW_LONGLONG_STATUS},
+  {"Compression_time",         (char*) offsetof(STATUS_VAR, compression_time), SHOW_DOUBLE_STATUS},
   {"Connections",              (char*) &global_thread_id,         SHOW_LONG_NOFLUSH},
   {"Connection_errors_accept", (char*) &connection_errors_accept, SHOW_LONG},
   {"Connection_errors_internal", (char*) &connection_errors_internal, SHOW_LONG},
@@ -8800,6 +8803,7 @@ void refresh_status(THD *thd)
   thd->status_var.global_memory_used= 0;
   bzero((uchar*) &thd->org_status_var, sizeof(thd->org_status_var)); 
   thd->start_bytes_received= 0;
+  thd->start_bytes_sent= 0;
 
   /* Reset some global variables */
   reset_status_vars();
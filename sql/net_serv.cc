@@ -133,6 +133,9 @@ extern my_bool thd_net_is_killed(THD *thd);
 
 static my_bool net_write_buff(NET *, const uchar *, size_t len);
 
+/* Largest size net_grow_write_buffer() gives the NET buffer */
+#define NET_MAX_WRITE_BUFFER_SIZE ((size_t) 1024*1024)
+
 my_bool net_allocate_new_packet(NET *net, void *thd, uint my_flags);
 
 /** Init with packet info. */
@@ -246,6 +249,68 @@ my_bool net_realloc(NET *net, size_t length)
 }
 
 
+#ifdef MYSQL_SERVER
+/**
+  Reallocate the NET buffer between commands.
+
+  Nothing is done if the buffer holds any data; if the memory can't be
+  allocated the old buffer is kept.
+*/
+
+static void net_resize_write_buffer(NET *net, size_t length)
+{
+  uchar *buff;
+  if (net->write_pos != net->buff || net->remain_in_buf)
+    return;
+
+  if (!(buff= (uchar*) my_realloc(key_memory_NET_buff,
+                                  (char*) net->buff, length +
+                                  NET_HEADER_SIZE + COMP_HEADER_SIZE + 1,
+                                  MYF(net->thread_specific_malloc
+                                      ? MY_THREAD_SPECIFIC : 0))))
+    return;
+  net->buff= net->write_pos= net->read_pos= buff;
+  net->buff_end= buff + (net->max_packet= (ulong) length);
+}
+
+
+/**
+  Double the size of the NET buffer, up to NET_MAX_WRITE_BUFFER_SIZE.
+
+  Used by the server between commands, for connections that receive
+  large results, so that these are sent with fewer and larger writes.
+*/
+
+void net_grow_write_buffer(NET *net)
+{
+  size_t length= MY_MIN((size_t) net->max_packet * 2,
+                        NET_MAX_WRITE_BUFFER_SIZE);
+  DBUG_ENTER("net_grow_write_buffer");
+
+  if (length > net->max_packet && length < net->max_packet_size)
+    net_resize_write_buffer(net, length);
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Give the NET buffer back its original size of 'length' bytes.
+
+  Used by the server between commands, once a connection that has grown
+  the buffer (for large results or large packets read) has been sending
+  only small results for a while.
+*/
+
+void net_shrink_write_buffer(NET *net, size_t length)
+{
+  DBUG_ENTER("net_shrink_write_buffer");
+  if (length < net->max_packet)
+    net_resize_write_buffer(net, length);
+  DBUG_VOID_RETURN;
+}
+#endif
+
+
 /**
   Check if there is any data to be read from the socket.
 
@@ -391,6 +456,10 @@ my_bool net_flush(NET *net)
                                   (size_t) (net->write_pos - net->buff)));
     net->write_pos= net->buff;
   }
+#ifdef MYSQL_SERVER
+  else if (net->thd && ((THD*) net->thd)->net_deferred_output.length())
+    error= MY_TEST(net_real_write(net, net->buff, 0));
+#endif
   /* Sync packet number if using compression */
   if (net->compress)
     net->pkt_nr=net->compress_pkt_nr;
@@ -398,6 +467,43 @@ my_bool net_flush(NET *net)
 }
 
 
+#ifdef MYSQL_SERVER
+/**
+  Flush the reply to a command, unless the client has already sent the
+  next one.
+
+  A client that pipelines its commands does not wait for the reply before
+  it sends the next command. If that command is already in the Vio read
+  buffer, the reply is moved from the NET buffer to
+  THD::net_deferred_output, which net_real_write() sends ahead of the
+  next data written to the connection. The NET buffer must be empty
+  before the next command is read into it.
+
+  Only data that is already buffered is checked, so this costs no system
+  call. With the compressed protocol the packets are numbered when they
+  are written, so there the reply is always flushed at once.
+*/
+
+my_bool net_flush_reply(NET *net)
+{
+  THD *thd= (THD*) net->thd;
+  size_t length= (size_t) (net->write_pos - net->buff);
+  DBUG_ENTER("net_flush_reply");
+
+  if (net->compress || !thd || !net->vio || !net->vio->has_data(net->vio) ||
+      thd->net_deferred_output.length() + length > net->max_packet ||
+      thd->net_deferred_output.append((const char*) net->buff, length))
+    DBUG_RETURN(net_flush(net));
+
+#ifdef USE_QUERY_CACHE
+  query_cache_insert(net->thd, (char*) net->buff, length, net->pkt_nr);
+#endif
+  net->write_pos= net->buff;
+  DBUG_RETURN(0);
+}
+#endif
+
+
 /*****************************************************************************
 ** Write something to server/client buffer
 *****************************************************************************/
@@ -420,6 +526,29 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
 
   MYSQL_NET_WRITE_START(len);
 
+  /*
+    Most packets, like the rows of a result set, fit into what is left of
+    the buffer. Store the header in place and copy the packet after it,
+    instead of going through net_write_buff() for each of them.
+  */
+  if (likely(len < MAX_PACKET_LENGTH &&
+             len + NET_HEADER_SIZE <=
+             (size_t) (net->buff_end - net->write_pos)) &&
+      !(net->compress && net->max_packet > MAX_PACKET_LENGTH))
+  {
+    uchar *pos= net->write_pos;
+    int3store(pos, len);
+    pos[3]= (uchar) net->pkt_nr++;
+    if (len)
+      memcpy(pos + NET_HEADER_SIZE, packet, len);
+#ifdef DEBUG_DATA_PACKETS
+    DBUG_DUMP("data_written", pos, len + NET_HEADER_SIZE);
+#endif
+    net->write_pos= pos + NET_HEADER_SIZE + len;
+    MYSQL_NET_WRITE_DONE(0);
+    return 0;
+  }
+
   /*
     Big packets are handled by splitting them in packets of MAX_PACKET_LENGTH
     length. The last packet is always a packet that is < MAX_PACKET_LENGTH.
@@ -619,6 +748,42 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 }
 
 
+#if defined(HAVE_COMPRESS) && defined(MYSQL_SERVER)
+/**
+  Compress a packet with the deflate context of the connection.
+
+  @param thd     Connection the packet is sent to
+  @param to      Where to store the packet, at least *len bytes
+  @param packet  Packet to compress
+  @param len     in: length of the packet, out: number of bytes stored at 'to'
+
+  @return Length of the original packet, or 0 if the packet is stored
+          uncompressed because compression did not make it shorter.
+*/
+
+static size_t net_compress_packet(THD *thd, uchar *to, const uchar *packet,
+                                  size_t *len)
+{
+  size_t complen= *len - 1;
+  ulonglong start= my_interval_timer();
+
+  if (my_compress_ctx(&thd->net_compress_ctx, to, &complen, packet, *len))
+  {
+    memcpy(to, packet, *len);
+    complen= 0;
+  }
+  else
+    swap_variables(size_t, *len, complen);
+
+  thd->status_var.compression_time+=
+    (double) (my_interval_timer() - start) / 1e9;
+  thd->status_var.compression_input_bytes+= complen ? complen : *len;
+  thd->status_var.compression_output_bytes+= *len;
+  return complen;
+}
+#endif /* HAVE_COMPRESS && MYSQL_SERVER */
+
+
 /**
   Read and write one packet using timeouts.
   If needed, the packet is compressed before sending.
@@ -638,15 +803,36 @@ net_real_write(NET *net,const uchar *packet, size_t len)
 #endif
   uint retry_count=0;
   my_bool net_blocking = vio_is_blocking(net->vio);
+#ifdef MYSQL_SERVER
+  String *deferred= 0;
+#endif
   DBUG_ENTER("net_real_write");
 
 #if defined(MYSQL_SERVER) && defined(USE_QUERY_CACHE)
-  query_cache_insert(net->thd, (char*) packet, len, net->pkt_nr);
+  if (len)
+    query_cache_insert(net->thd, (char*) packet, len, net->pkt_nr);
 #endif
 
   if (unlikely(net->error == 2))
     DBUG_RETURN(-1);				/* socket can't be used */
 
+#ifdef MYSQL_SERVER
+  if (net->thd && ((THD*) net->thd)->net_deferred_output.length())
+  {
+    /* Send the replies held back by net_flush_reply() first */
+    DBUG_ASSERT(!net->compress);
+    deferred= &((THD*) net->thd)->net_deferred_output;
+    if (deferred->append((const char*) packet, len))
+    {
+      net->error= 2;
+      net->last_errno= ER_OUT_OF_RESOURCES;
+      DBUG_RETURN(1);
+    }
+    packet= (const uchar*) deferred->ptr();
+    len= deferred->length();
+  }
+#endif
+
   net->reading_or_writing=2;
 #ifdef HAVE_COMPRESS
   if (net->compress)
@@ -665,11 +851,20 @@ net_real_write(NET *net,const uchar *packet, size_t len)
       net->reading_or_writing= 0;
       DBUG_RETURN(1);
     }
-    memcpy(b+header_length,packet,len);
-
+#ifdef MYSQL_SERVER
     /* Don't compress error packets (compress == 2) */
-    if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
-      complen=0;
+    if (net->thd && net->compress != 2 && len >= MIN_COMPRESS_LENGTH)
+      complen= net_compress_packet((THD*) net->thd, b+header_length,
+                                   packet, &len);
+    else
+#endif
+    {
+      memcpy(b+header_length,packet,len);
+
+      /* Don't compress error packets (compress == 2) */
+      if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
+        complen=0;
+    }
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
     b[3]=(uchar) (net->compress_pkt_nr++);
@@ -752,6 +947,10 @@ net_real_write(NET *net,const uchar *packet, size_t len)
 #ifdef HAVE_COMPRESS
   if (net->compress)
     my_free((void*) packet);
+#endif
+#ifdef MYSQL_SERVER
+  if (deferred)
+    deferred->length(0);
 #endif
   if (thr_alarm_in_use(&alarmed))
   {
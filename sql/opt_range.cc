@@ -340,6 +340,7 @@ class TABLE_READ_PLAN;
   class TRP_INDEX_INTERSECT;
   class TRP_INDEX_MERGE;
   class TRP_GROUP_MIN_MAX;
+  class TRP_SKIP_SCAN;
 
 struct st_index_scan_info;
 struct st_ror_scan_info;
@@ -378,6 +379,9 @@ TABLE_READ_PLAN *merge_same_index_scans(PARAM *param, SEL_IMERGE *imerge,
 static
 TRP_GROUP_MIN_MAX *get_best_group_min_max(PARAM *param, SEL_TREE *tree,
                                           double read_time);
+static
+TRP_SKIP_SCAN *get_best_skip_scan(PARAM *param, SEL_TREE *tree,
+                                  double read_time);
 
 #ifndef DBUG_OFF
 static void print_sel_tree(PARAM *param, SEL_TREE *tree, key_map *tree_map,
@@ -2503,6 +2507,51 @@ void TRP_GROUP_MIN_MAX::trace_basic_info(PARAM *param,
 }
 
 
+/*
+  Plan for a QUICK_SKIP_SCAN_SELECT scan.
+*/
+
+class TRP_SKIP_SCAN : public TABLE_READ_PLAN
+{
+public:
+  SEL_ARG *key;     /* intervals over the key parts after the prefix */
+  uint key_idx;     /* key number in PARAM::key */
+  uint prefix_key_parts; /* number of key parts that are skipped */
+  ha_rows prefixes; /* estimate of # of distinct prefix values */
+
+  TRP_SKIP_SCAN(SEL_ARG *key_arg, uint idx_arg, uint prefix_key_parts_arg,
+                ha_rows prefixes_arg)
+   : key(key_arg), key_idx(idx_arg), prefix_key_parts(prefix_key_parts_arg),
+     prefixes(prefixes_arg)
+  {}
+  virtual ~TRP_SKIP_SCAN() {}                 /* Remove gcc warning */
+
+  QUICK_SELECT_I *make_quick(PARAM *param, bool retrieve_full_rows,
+                             MEM_ROOT *parent_alloc);
+  void trace_basic_info(PARAM *param,
+                        Json_writer_object *trace_object) const;
+};
+
+
+void TRP_SKIP_SCAN::trace_basic_info(PARAM *param,
+                                     Json_writer_object *trace_object) const
+{
+  THD *thd= param->thd;
+  DBUG_ASSERT(trace_object->trace_started());
+  const KEY &cur_key= param->table->key_info[param->real_keynr[key_idx]];
+
+  trace_object->add("type", "skip_scan")
+               .add("index", cur_key.name)
+               .add("distinct_prefixes", prefixes)
+               .add("rows", records)
+               .add("cost", read_cost);
+
+  Json_writer_array trace_keyparts(thd, "skipped_key_parts");
+  for (uint partno= 0; partno < prefix_key_parts; partno++)
+    trace_keyparts.add(cur_key.key_part[partno].field->field_name);
+}
+
+
 typedef struct st_index_scan_info
 {
   uint      idx;      /* # of used key in param->keys */
@@ -3027,6 +3076,28 @@ int SQL_SELECT::test_quick_select(THD *thd, key_map keys_to_use,
         remove_nonrange_trees(&param, tree);
     }
 
+    /*
+      Try to construct a QUICK_SKIP_SCAN_SELECT. It is built from the range
+      trees that do not start from the first key part.
+    */
+    if (tree && !only_single_index_range_scan &&
+        optimizer_flag(thd, OPTIMIZER_SWITCH_SKIP_SCAN))
+    {
+      TRP_SKIP_SCAN *skip_trp;
+      restore_nonrange_trees(&param, tree, backup_keys);
+      if ((skip_trp= get_best_skip_scan(&param, tree, best_read_time)))
+      {
+        Json_writer_object skip_summary(thd, "best_skip_scan_summary");
+
+        if (unlikely(thd->trace_started()))
+          skip_trp->trace_basic_info(&param, &skip_summary);
+        skip_summary.add("chosen", true);
+        best_trp= skip_trp;
+        best_read_time= best_trp->read_cost;
+      }
+      remove_nonrange_trees(&param, tree);
+    }
+
     thd->mem_root= param.old_root;
 
     /* If we got a read plan, create a quick select from it. */
@@ -7905,6 +7976,30 @@ SEL_TREE *Item_func_in::get_func_mm_tree(RANGE_OPT_PARAM *param,
   }
   else
   {
+    if (array && array->used_count > SEL_ARG::MAX_SEL_ARGS &&
+        array->type_handler()->result_type() != ROW_RESULT)
+    {
+      /*
+        Building, estimating and scanning that many single point ranges
+        costs more than it can save. Use one range from the smallest to the
+        largest value (the array is sorted) instead; the IN predicate is
+        still checked for the rows read.
+      */
+      MEM_ROOT *tmp_root= param->mem_root;
+      param->thd->mem_root= param->old_root;
+      Item *value_item= array->create_item(param->thd);
+      param->thd->mem_root= tmp_root;
+      if (!value_item)
+        DBUG_RETURN(0);
+
+      array->value_to_item(0, value_item);
+      tree= get_mm_parts(param, field, Item_func::GE_FUNC, value_item);
+      array->value_to_item(array->used_count - 1, value_item);
+      tree= tree_and(param, tree, get_mm_parts(param, field,
+                                               Item_func::LE_FUNC,
+                                               value_item));
+      DBUG_RETURN(tree);
+    }
     tree= get_mm_parts(param, field, Item_func::EQ_FUNC, args[1]);
     if (tree)
     {
@@ -8270,7 +8365,16 @@ SEL_TREE *Item_cond_and::get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr)
   {
     SEL_TREE *new_tree= li.ref()[0]->get_mm_tree(param,li.ref());
     if (param->statement_should_be_aborted())
-      DBUG_RETURN(NULL);
+    {
+      /*
+        If we ran out of SEL_ARGs, the ranges built for the preceding
+        conjuncts still contain all the rows satisfying the condition.
+        Use these coarser ranges rather than no ranges at all.
+      */
+      if (param->thd->killed || param->thd->is_error())
+        DBUG_RETURN(NULL);
+      DBUG_RETURN(tree);
+    }
     tree= tree_and(param, tree, new_tree);
     if (tree && tree->type == SEL_TREE::IMPOSSIBLE)
     {
@@ -12675,6 +12779,308 @@ bool QUICK_SELECT_DESC::range_reads_after_key(QUICK_RANGE *range_arg)
 }
 
 
+/*
+  Find the best skip scan over the range trees that have conditions on some
+  key part but none on the key parts before it.
+
+  SYNOPSIS
+    get_best_skip_scan()
+      param     Parameter from test_quick_select
+      tree      Range tree with the non-range trees restored
+      read_time Cost of the best plan found so far
+
+  DESCRIPTION
+    The skipped prefix consists of the key parts before the first one that
+    has a range. The number of distinct prefix values is taken from the index
+    statistics, so indexes without them are not considered. The rows read
+    for one prefix value cannot be estimated with records_in_range() because
+    the ranges do not start from the first key part. They are guessed from
+    the statistics too: rec_per_key of the first ranged key part for
+    "kp = const", and a third of the prefix group for other intervals.
+
+    The cost is one index dive per interval and prefix value, plus one to
+    find the next prefix value, and the cost of reading the rows.
+
+  RETURN
+    The cheapest skip scan plan, if it is cheaper than read_time.
+    NULL otherwise.
+*/
+
+static TRP_SKIP_SCAN *get_best_skip_scan(PARAM *param, SEL_TREE *tree,
+                                         double read_time)
+{
+  TABLE *table= param->table;
+  handler *file= table->file;
+  ha_rows table_records= table->stat_records();
+  TRP_SKIP_SCAN *read_plan= NULL;
+  DBUG_ENTER("get_best_skip_scan");
+
+  for (uint idx= 0; idx < param->keys; idx++)
+  {
+    SEL_ARG *key_tree= tree->keys[idx];
+    uint keynr= param->real_keynr[idx];
+    KEY *key_info= table->key_info + keynr;
+    uint prefix_key_parts;
+    double rec_per_prefix, prefixes, dives, rows= 0.0;
+    const ulong needed_flags= HA_READ_NEXT | HA_READ_ORDER | HA_READ_RANGE;
+
+    if (!key_tree || key_tree->type != SEL_ARG::KEY_RANGE ||
+        !(prefix_key_parts= key_tree->part))
+      continue;
+    if ((key_info->flags & HA_SPATIAL) ||
+        (file->index_flags(keynr, prefix_key_parts, 1) & needed_flags) !=
+        needed_flags)
+      continue;
+    if (!(rec_per_prefix= key_info->actual_rec_per_key(prefix_key_parts - 1)))
+      continue;
+
+    prefixes= MY_MAX(rows2double(table_records) / rec_per_prefix, 1.0);
+    dives= prefixes;
+    for (SEL_ARG *arg= key_tree->first(); arg; arg= arg->next)
+    {
+      double rec_per_value;
+      dives+= prefixes;
+      if (arg->is_singlepoint() &&
+          (rec_per_value= key_info->actual_rec_per_key(prefix_key_parts)))
+        rows+= rec_per_value;
+      else
+        rows+= rec_per_prefix / 3;
+    }
+    rows= MY_MIN(rows * prefixes, rows2double(table_records));
+
+    Cost_estimate cost;
+    bool index_only= table->covering_keys.is_set(keynr);
+    cost.avg_io_cost= cost.idx_avg_io_cost= file->avg_io_cost();
+    cost.idx_io_count= dives;
+    cost.idx_cpu_cost= (file->keyread_time(keynr, 0, (ha_rows) rows) +
+                        dives * IDX_LOOKUP_COST);
+    if (!index_only)
+      cost.cpu_cost= file->read_time(keynr, 0, (ha_rows) rows);
+    cost.cpu_cost+= rows / TIME_FOR_COMPARE;
+
+    DBUG_PRINT("info", ("index: %s  prefixes: %.0f  rows: %.0f  cost: %.3f",
+                        key_info->name.str, prefixes, rows,
+                        cost.total_cost()));
+    if (cost.total_cost() < read_time &&
+        (read_plan= new (param->mem_root)
+                    TRP_SKIP_SCAN(key_tree, idx, prefix_key_parts,
+                                  (ha_rows) prefixes)))
+    {
+      read_time= cost.total_cost();
+      read_plan->read_cost= read_time;
+      read_plan->records= (ha_rows) rows;
+      read_plan->is_ror= FALSE;
+    }
+  }
+  DBUG_RETURN(read_plan);
+}
+
+
+QUICK_SELECT_I *TRP_SKIP_SCAN::make_quick(PARAM *param,
+                                          bool retrieve_full_rows,
+                                          MEM_ROOT *parent_alloc)
+{
+  QUICK_SKIP_SCAN_SELECT *quick;
+  bool create_err= FALSE;
+  uint keynr= param->real_keynr[key_idx];
+  DBUG_ENTER("TRP_SKIP_SCAN::make_quick");
+
+  if (!(quick= new QUICK_SKIP_SCAN_SELECT(param->thd, param->table, keynr,
+                                          prefix_key_parts, parent_alloc,
+                                          &create_err)))
+    DBUG_RETURN(NULL);
+  if (create_err ||
+      get_quick_keys(param, quick, param->key[key_idx], key,
+                     param->min_key, 0, param->max_key, 0))
+  {
+    delete quick;
+    DBUG_RETURN(NULL);
+  }
+  KEY *keyinfo= param->table->key_info + keynr;
+  quick->key_parts= (KEY_PART*)
+    memdup_root(parent_alloc ? parent_alloc : &quick->alloc,
+                (char*) param->key[key_idx],
+                sizeof(KEY_PART) * param->table->actual_n_key_parts(keyinfo));
+  /* The ranges start after the prefix, the index lookups include it */
+  quick->max_used_key_length+= quick->prefix_len;
+  quick->records= records;
+  quick->read_time= read_cost;
+  quick->mark_prefix_columns();
+  DBUG_RETURN(quick);
+}
+
+
+QUICK_SKIP_SCAN_SELECT::QUICK_SKIP_SCAN_SELECT(THD *thd, TABLE *table,
+                                               uint index_arg,
+                                               uint prefix_key_parts_arg,
+                                               MEM_ROOT *parent_alloc,
+                                               bool *create_err)
+  :QUICK_RANGE_SELECT(thd, table, index_arg, MY_TEST(parent_alloc),
+                      parent_alloc, create_err),
+   prefix_key_parts(prefix_key_parts_arg), prefix_len(0),
+   prefix_keypart_map(make_prev_keypart_map(prefix_key_parts_arg)),
+   min_key_buf(NULL), max_key_buf(NULL), have_prefix(FALSE)
+{
+  for (uint part= 0; part < prefix_key_parts; part++)
+    prefix_len+= key_part_info[part].store_length;
+  /* The ranges are read one by one, MRR is not used */
+  mrr_flags= HA_MRR_USE_DEFAULT_IMPL | HA_MRR_SORTED;
+  mrr_buf_size= 0;
+}
+
+
+int QUICK_SKIP_SCAN_SELECT::init()
+{
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::init");
+  if (!min_key_buf)
+  {
+    MEM_ROOT *mem_root= parent_alloc ? parent_alloc : &alloc;
+    if (!(min_key_buf= (uchar*) alloc_root(mem_root, max_used_key_length)) ||
+        !(max_key_buf= (uchar*) alloc_root(mem_root, max_used_key_length)))
+      DBUG_RETURN(1);
+  }
+  mark_prefix_columns();
+  DBUG_RETURN(QUICK_RANGE_SELECT::init());
+}
+
+
+/*
+  Add the skipped prefix key parts to the read set.
+
+  NOTES
+    next_prefix() copies the prefix from the record, but the query need
+    not reference these columns, and engines like InnoDB don't read index
+    columns that are not in the read set. This must be done before the
+    handler is initialized for the index.
+*/
+
+void QUICK_SKIP_SCAN_SELECT::mark_prefix_columns()
+{
+  for (uint part= 0; part < prefix_key_parts; part++)
+    bitmap_set_bit(head->read_set, key_part_info[part].field->field_index);
+}
+
+
+int QUICK_SKIP_SCAN_SELECT::reset()
+{
+  int error;
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::reset");
+  last_range= NULL;
+  cur_range= (QUICK_RANGE**) ranges.buffer;
+  have_prefix= FALSE;
+  mark_prefix_columns();
+
+  if (file->inited == handler::RND)
+  {
+    if (unlikely((error= file->ha_rnd_end())))
+      DBUG_RETURN(error);
+  }
+  if (file->inited == handler::NONE)
+  {
+    if (unlikely((error= file->ha_index_init(index, 1))))
+    {
+      file->print_error(error, MYF(0));
+      DBUG_RETURN(error);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Find the next value of the skipped key prefix.
+
+  NOTES
+    The prefix is copied to the start of min_key_buf and max_key_buf, and
+    the ranges are rewound.
+
+  RETURN
+    0                   Found
+    HA_ERR_END_OF_FILE  No more prefix values
+    #                   Error code
+*/
+
+int QUICK_SKIP_SCAN_SELECT::next_prefix()
+{
+  int result;
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::next_prefix");
+
+  /* The end of the last range must not stop the jump */
+  file->set_end_range(NULL);
+  if (!have_prefix)
+    result= file->ha_index_first(record);
+  else
+    result= file->ha_index_read_map(record, min_key_buf, prefix_keypart_map,
+                                    HA_READ_AFTER_KEY);
+  if (result)
+    DBUG_RETURN(result == HA_ERR_KEY_NOT_FOUND ? HA_ERR_END_OF_FILE : result);
+
+  key_copy(min_key_buf, record, head->key_info + index, prefix_len);
+  memcpy(max_key_buf, min_key_buf, prefix_len);
+  have_prefix= TRUE;
+  cur_range= (QUICK_RANGE**) ranges.buffer;
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Get the next row of the skip scan.
+
+  NOTES
+    Record is read into table->record[0]
+
+  RETURN
+    0                   Found row
+    HA_ERR_END_OF_FILE  No (more) rows in range
+    #                   Error code
+*/
+
+int QUICK_SKIP_SCAN_SELECT::get_next()
+{
+  QUICK_RANGE **end_range= (QUICK_RANGE**) ranges.buffer + ranges.elements;
+  DBUG_ENTER("QUICK_SKIP_SCAN_SELECT::get_next");
+
+  for (;;)
+  {
+    int result;
+    if (last_range)
+    {
+      if ((result= file->read_range_next()) != HA_ERR_END_OF_FILE)
+        DBUG_RETURN(result);
+      last_range= NULL;
+    }
+
+    if (!have_prefix || cur_range == end_range)
+    {
+      if ((result= next_prefix()))
+        DBUG_RETURN(result);
+    }
+    last_range= *(cur_range++);
+
+    key_range start_key, end_key;
+    last_range->make_min_endpoint(&start_key);
+    last_range->make_max_endpoint(&end_key);
+    memcpy(min_key_buf + prefix_len, last_range->min_key,
+           last_range->min_length);
+    memcpy(max_key_buf + prefix_len, last_range->max_key,
+           last_range->max_length);
+    start_key.key= min_key_buf;
+    start_key.length+= prefix_len;
+    start_key.keypart_map|= prefix_keypart_map;
+    end_key.key= max_key_buf;
+    end_key.length+= prefix_len;
+    end_key.keypart_map|= prefix_keypart_map;
+
+    result= file->read_range_first(&start_key, &end_key,
+                                   MY_TEST(last_range->flag & EQ_RANGE),
+                                   TRUE);
+    if (result != HA_ERR_END_OF_FILE)
+      DBUG_RETURN(result);
+    last_range= NULL;                   // No matching rows; go to next range
+  }
+}
+
+
 void QUICK_SELECT_I::add_key_name(String *str, bool *first)
 {
   KEY *key_info= head->key_info + index;
@@ -12696,6 +13102,16 @@ Explain_quick_select* QUICK_RANGE_SELECT::get_explain(MEM_ROOT *local_alloc)
 }
 
 
+Explain_quick_select*
+QUICK_SKIP_SCAN_SELECT::get_explain(MEM_ROOT *local_alloc)
+{
+  Explain_quick_select *res;
+  if ((res= new (local_alloc) Explain_quick_select(QS_TYPE_SKIP_SCAN)))
+    res->range.set(local_alloc, &head->key_info[index], max_used_key_length);
+  return res;
+}
+
+
 Explain_quick_select*
 QUICK_GROUP_MIN_MAX_SELECT::get_explain(MEM_ROOT *local_alloc)
 {
@@ -15858,6 +16274,16 @@ void QUICK_RANGE_SELECT::dbug_dump(int indent, bool verbose)
   /* purecov: end */    
 }
 
+void QUICK_SKIP_SCAN_SELECT::dbug_dump(int indent, bool verbose)
+{
+  /* purecov: begin inspected */
+  fprintf(DBUG_FILE, "%*squick skip scan select, key %s, length: %d, "
+          "skipped key parts: %u, ranges: %u\n",
+          indent, "", head->key_info[index].name.str, max_used_key_length,
+          prefix_key_parts, (uint) ranges.elements);
+  /* purecov: end */
+}
+
 void QUICK_INDEX_SORT_SELECT::dbug_dump(int indent, bool verbose)
 {
   List_iterator_fast<QUICK_RANGE_SELECT> it(quick_selects);
@@ -933,7 +933,8 @@ class QUICK_SELECT_I
     QS_TYPE_FULLTEXT   = 4,
     QS_TYPE_ROR_INTERSECT = 5,
     QS_TYPE_ROR_UNION = 6,
-    QS_TYPE_GROUP_MIN_MAX = 7
+    QS_TYPE_GROUP_MIN_MAX = 7,
+    QS_TYPE_SKIP_SCAN = 8
   };
 
   /* Get type of this quick select - one of the QS_TYPE_* values */
@@ -1622,6 +1623,54 @@ class QUICK_SELECT_DESC: public QUICK_RANGE_SELECT
 };
 
 
+/*
+  Index skip scan: a range scan over a key suffix for every distinct value
+  of the key prefix before it.
+
+  This is used for queries like
+
+    SELECT ... FROM t1 WHERE kp2 BETWEEN c1 AND c2 ...
+
+  where there is an index on (kp1, kp2, ...) but no condition on kp1. The
+  ranges are built over kp2,... only. For every value of kp1 found in the
+  index, get_next() prepends it to each of the ranges and reads them with
+  read_range_first()/read_range_next(); after the last range it jumps to the
+  next kp1 value with an index lookup. The rows are returned in index order.
+*/
+
+class QUICK_SKIP_SCAN_SELECT: public QUICK_RANGE_SELECT
+{
+public:
+  QUICK_SKIP_SCAN_SELECT(THD *thd, TABLE *table, uint index_arg,
+                         uint prefix_key_parts_arg, MEM_ROOT *parent_alloc,
+                         bool *create_err);
+  virtual QUICK_RANGE_SELECT *clone(bool *create_error)
+    { DBUG_ASSERT(0); return NULL; }
+  int init();
+  int reset(void);
+  int get_next();
+  void need_sorted_output() { /* always sorted */ }
+  bool unique_key_range() { return false; }
+  int get_type() { return QS_TYPE_SKIP_SCAN; }
+  QUICK_SELECT_I *make_reverse(uint used_key_parts_arg) { return NULL; }
+  Explain_quick_select *get_explain(MEM_ROOT *alloc);
+#ifndef DBUG_OFF
+  void dbug_dump(int indent, bool verbose);
+#endif
+private:
+  uint prefix_key_parts;   /* Number of key parts in the skipped prefix */
+  uint prefix_len;         /* Length of the prefix in the key buffers */
+  key_part_map prefix_keypart_map;
+  uchar *min_key_buf;      /* Current prefix followed by the range start */
+  uchar *max_key_buf;      /* Current prefix followed by the range end */
+  bool have_prefix;        /* min_key_buf/max_key_buf hold a valid prefix */
+
+  int next_prefix();
+  void mark_prefix_columns();
+  friend class TRP_SKIP_SCAN;
+};
+
+
 class SQL_SELECT :public Sql_alloc {
  public:
   QUICK_SELECT_I *quick;	// If quick-select used
@@ -173,12 +173,18 @@ class Table_access_tracker
 public:
   Table_access_tracker() :
     r_scans(0), r_rows(0), /*r_rows_after_table_cond(0),*/
-    r_rows_after_where(0)
+    r_rows_after_where(0), r_rows_skipped(0)
   {}
 
   ha_rows r_scans; /* How many scans were ran on this join_tab */
   ha_rows r_rows; /* How many rows we've got after that */
   ha_rows r_rows_after_where; /* Rows after applying attached part of WHERE */
+  /*
+    Rows that were dropped before the attached part of WHERE was checked,
+    because the join buffer could tell they have no match (Bloom filter of
+    a BNLH join). They are not counted in r_filtered.
+  */
+  ha_rows r_rows_skipped;
 
   bool has_scans() const { return (r_scans != 0); }
   ha_rows get_loops() const { return r_scans; }
@@ -191,15 +197,23 @@ class Table_access_tracker
 
   double get_filtered_after_where() const
   {
-    return r_rows > 0
+    return r_rows > r_rows_skipped
       ? static_cast<double>(r_rows_after_where) /
-        static_cast<double>(r_rows)
+        static_cast<double>(r_rows - r_rows_skipped)
       : 1.0;
   }
 
+  double get_avg_rows_skipped() const
+  {
+    return r_scans
+      ? static_cast<double>(r_rows_skipped) / static_cast<double>(r_scans)
+      : 0;
+  }
+
   inline void on_scan_init() { r_scans++; }
   inline void on_record_read() { r_rows++; }
   inline void on_record_after_where() { r_rows_after_where++; }
+  inline void on_record_skipped() { r_rows_skipped++; }
 };
 
 
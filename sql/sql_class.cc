@@ -817,6 +817,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
   net.vio=0;
   net.buff= 0;
   net.reading_or_writing= 0;
+  net_compress_ctx= 0;
   client_capabilities= 0;                       // minimalistic client
   system_thread= NON_SYSTEM_THREAD;
   cleanup_done= free_connection_done= abort_on_warning= 0;
@@ -1289,6 +1290,8 @@ void THD::init()
   bzero((char *) &org_status_var, sizeof(org_status_var));
   status_in_global= 0;
   start_bytes_received= 0;
+  start_bytes_sent= 0;
+  net_small_commands= 0;
   m_last_commit_gtid.seq_no= 0;
   last_stmt= NULL;
   /* Reset status of last insert id */
@@ -1621,6 +1624,10 @@ void THD::free_connection()
     vio_delete(net.vio);
   net.vio= 0;
   net_end(&net);
+  net_deferred_output.free();
+#endif
+#ifdef HAVE_COMPRESS
+  my_compress_ctx_free(&net_compress_ctx);
 #endif
  if (!cleanup_done)
    cleanup();
@@ -1804,6 +1811,9 @@ void add_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var)
   to_var->table_open_cache_hits+= from_var->table_open_cache_hits;
   to_var->table_open_cache_misses+= from_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows;
+  to_var->compression_input_bytes+= from_var->compression_input_bytes;
+  to_var->compression_output_bytes+= from_var->compression_output_bytes;
+  to_var->compression_time+=    from_var->compression_time;
 
   /*
     Update global_memory_used. We have to do this with atomic_add as the
@@ -1861,6 +1871,12 @@ void add_diff_to_status(STATUS_VAR *to_var, STATUS_VAR *from_var,
                                     dec_var->table_open_cache_misses;
   to_var->table_open_cache_overflows+= from_var->table_open_cache_overflows -
                                        dec_var->table_open_cache_overflows;
+  to_var->compression_input_bytes+= from_var->compression_input_bytes -
+                                    dec_var->compression_input_bytes;
+  to_var->compression_output_bytes+= from_var->compression_output_bytes -
+                                     dec_var->compression_output_bytes;
+  to_var->compression_time+=     from_var->compression_time -
+                                 dec_var->compression_time;
 
   /*
     We don't need to accumulate memory_used as these are not reset or used by
@@ -4252,6 +4268,8 @@ void TMP_TABLE_PARAM::init()
   materialized_subquery= 0;
   force_not_null_cols= 0;
   skip_create_table= 0;
+  last_group_buff= 0;
+  last_group_positioned= 0;
   DBUG_VOID_RETURN;
 }
 
@@ -707,6 +707,7 @@ typedef struct system_variables
   ulong range_alloc_block_size;
   ulong query_alloc_block_size;
   ulong query_prealloc_size;
+  ulong query_alloc_keep_size;
   ulong trans_alloc_block_size;
   ulong trans_prealloc_size;
   ulong log_warnings;
@@ -752,6 +753,7 @@ typedef struct system_variables
   my_bool binlog_annotate_row_events;
   my_bool binlog_direct_non_trans_update;
   my_bool column_compression_zlib_wrap;
+  my_bool optimizer_reuse_join_order;
 
   plugin_ref table_plugin;
   plugin_ref tmp_table_plugin;
@@ -955,8 +957,11 @@ typedef struct system_status_var
   ulonglong table_open_cache_misses;
   ulonglong table_open_cache_overflows;
   ulonglong send_metadata_skips;
+  /* Packets given to the protocol compression and their compressed size */
+  ulonglong compression_input_bytes;
+  ulonglong compression_output_bytes;
   double last_query_cost;
-  double cpu_time, busy_time;
+  double cpu_time, busy_time, compression_time;
   uint32 threads_running;
   /* Don't initialize */
   /* Memory used for thread local storage */
@@ -2392,6 +2397,10 @@ class THD: public THD_count, /* this must be first */
   NET	  net;				// client connection descriptor
   /** Aditional network instrumentation for the server only. */
   NET_SERVER m_net_server_extension;
+  /** Deflate context for the compressed protocol, see my_compress_ctx() */
+  void *net_compress_ctx;
+  /** Replies held back for pipelined commands, see net_flush_reply() */
+  String net_deferred_output;
   scheduler_functions *scheduler;       // Scheduler for this connection
   Protocol *protocol;			// Current protocol
   Protocol_text   protocol_text;	// Normal protocol
@@ -3369,6 +3378,10 @@ class THD: public THD_count, /* this must be first */
   uint select_commands, update_commands, other_commands;
   ulonglong start_cpu_time;
   ulonglong start_bytes_received;
+  /* bytes_sent when the last command was read, see do_command() */
+  ulonglong start_bytes_sent;
+  /* Number of commands in a row that sent small results, see do_command() */
+  uint net_small_commands;
 
   /* Used by the sys_var class to store temporary values */
   union
@@ -5884,6 +5897,11 @@ class TMP_TABLE_PARAM :public Sql_alloc
   List<Item> copy_funcs;
   Copy_field *copy_field, *copy_field_end;
   uchar	    *group_buff;
+  /*
+    Copy of group_buff for the group the tmp table handler was last
+    positioned on by end_update(). Only valid if last_group_positioned.
+  */
+  uchar	    *last_group_buff;
   Item	    **items_to_copy;			/* Fields in tmp table */
   TMP_ENGINE_COLUMNDEF *recinfo, *start_recinfo;
   KEY *keyinfo;
@@ -5949,14 +5967,21 @@ class TMP_TABLE_PARAM :public Sql_alloc
     TRUE <=> create_tmp_table will create only the TABLE structure.
   */
   bool skip_create_table;
+  /*
+    TRUE <=> the tmp table handler is positioned on the group stored in
+    last_group_buff and record[1] holds its current row image, so that
+    end_update() can update it without another index lookup.
+  */
+  bool last_group_positioned;
 
   TMP_TABLE_PARAM()
-    :copy_field(0), group_parts(0),
+    :copy_field(0), last_group_buff(0), group_parts(0),
      group_length(0), group_null_parts(0),
      using_outer_summary_function(0),
      schema_table(0), materialized_subquery(0), force_not_null_cols(0),
      precomputed_group_by(0),
-     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0)
+     force_copy_fields(0), bit_fields_as_long(0), skip_create_table(0),
+     last_group_positioned(0)
   {}
   ~TMP_TABLE_PARAM()
   {
@@ -1595,6 +1595,9 @@ void Explain_table_access::tag_to_json(Json_writer *writer, enum explain_extra_t
     case ET_USING_MRR:
       writer->add_member("mrr_type").add_str(mrr_type.c_ptr());
       break;
+    case ET_USING_INDEX_FOR_SKIP_SCAN:
+      writer->add_member("using_index_for_skip_scan").add_bool(true);
+      break;
     case ET_USING_INDEX_FOR_GROUP_BY:
       writer->add_member("using_index_for_group_by");
       if (loose_scan_is_scanning)
@@ -1839,7 +1842,13 @@ void Explain_table_access::print_explain_json(Explain_query *query,
         writer->add_double(tracker.get_filtered_after_where()*100.0);
       else
         writer->add_null();
+      /* Rows the join buffer dropped without checking the condition */
+      if (tracker.r_rows_skipped)
+        writer->add_member("r_rows_skipped").
+          add_double(tracker.get_avg_rows_skipped());
     }
+    if (r_cardinality_misestimate)
+      writer->add_member("r_cardinality_misestimate").add_bool(true);
   }
 
   for (int i=0; i < (int)extra_tags.elements(); i++)
@@ -1948,6 +1957,7 @@ const char * extra_tag_text[]=
   "Scanned all databases",
 
   "Using index for group-by", // special handling
+  "Using index for skip scan",
 
   "USING MRR: DONT PRINT ME", // special handling
 
@@ -2045,7 +2055,8 @@ void Explain_quick_select::print_extra(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     /* print nothing */
   }
@@ -2131,7 +2142,8 @@ void Explain_quick_select::print_key(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC || 
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     if (str->length() > 0)
       str->append(',');
@@ -2157,7 +2169,8 @@ void Explain_quick_select::print_key_len(String *str)
 {
   if (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
       quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX)
+      quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+      quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
   {
     char buf[64];
     size_t length;
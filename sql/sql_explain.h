@@ -536,6 +536,7 @@ enum explain_extra_tag
   ET_SCANNED_ALL_DATABASES,
 
   ET_USING_INDEX_FOR_GROUP_BY,
+  ET_USING_INDEX_FOR_SKIP_SCAN,
 
   ET_USING_MRR, // does not print "Using mrr". 
 
@@ -660,7 +661,8 @@ class Explain_quick_select : public Sql_alloc
   {
     return (quick_type == QUICK_SELECT_I::QS_TYPE_RANGE || 
             quick_type == QUICK_SELECT_I::QS_TYPE_RANGE_DESC ||
-            quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX);
+            quick_type == QUICK_SELECT_I::QS_TYPE_GROUP_MIN_MAX ||
+            quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN);
   }
   
   /* This is used when quick_type == QUICK_SELECT_I::QS_TYPE_RANGE */
@@ -732,7 +734,8 @@ class Explain_table_access : public Sql_alloc
     pushed_index_cond(NULL),
     sjm_nest(NULL),
     pre_join_sort(NULL),
-    rowid_filter(NULL)
+    rowid_filter(NULL),
+    r_cardinality_misestimate(false)
   {}
   ~Explain_table_access() { delete sjm_nest; }
 
@@ -843,6 +846,12 @@ class Explain_table_access : public Sql_alloc
   
   Explain_rowid_filter *rowid_filter;
 
+  /*
+    The rows read per scan differed from the estimate by more than
+    CARDINALITY_MISESTIMATE_RATIO, see JOIN::check_cardinality_estimates()
+  */
+  bool r_cardinality_misestimate;
+
   int print_explain(select_result_sink *output, uint8 explain_flags, 
                     bool is_analyze,
                     uint select_id, const char *select_type,
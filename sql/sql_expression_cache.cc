@@ -33,6 +33,11 @@
   impact in the case when the cache is not applicable)
 */
 #define EXPCACHE_CHECK_HIT_RATIO_AFTER 200
+/**
+  Maximum length of the key image of an expression cache kept in a hash
+  in memory instead of a temporary table
+*/
+#define EXPCACHE_MAX_HASH_KEY_LENGTH 64
 
 /*
   Expression cache is used only for caching subqueries now, so its statistic
@@ -44,7 +49,8 @@ Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
                                                      List<Item> &dependants,
                                                      Item *value)
   :cache_table(NULL), table_thd(thd), tracker(NULL), items(dependants), val(value),
-   hit(0), miss(0), inited (0)
+   hit(0), miss(0), hash_size(0), hash_have_key(0), use_hash(0),
+   inited (0)
 {
   DBUG_ENTER("Expression_cache_tmptable::Expression_cache_tmptable");
   DBUG_VOID_RETURN;
@@ -57,6 +63,12 @@ Expression_cache_tmptable::Expression_cache_tmptable(THD *thd,
 
 void Expression_cache_tmptable::disable_cache()
 {
+  if (use_hash)
+  {
+    my_hash_free(&hash);
+    free_root(&hash_root, MYF(0));
+    use_hash= FALSE;
+  }
   if (cache_table->file->inited)
     cache_table->file->ha_index_end();
   free_tmp_table(table_thd, cache_table);
@@ -155,8 +167,13 @@ void Expression_cache_tmptable::init()
   ref.has_record= 0;
   ref.use_count= 0;
 
+  if (init_hash())
+  {
+    DBUG_PRINT("error", ("Creating the hash failed"));
+    goto error;
+  }
 
-  if (open_tmp_table(cache_table))
+  if (!use_hash && open_tmp_table(cache_table))
   {
     DBUG_PRINT("error", ("Opening (creating) temporary table failed"));
     goto error;
@@ -194,6 +211,51 @@ Expression_cache_tmptable::~Expression_cache_tmptable()
 }
 
 
+/**
+  Keep the cache in a hash in memory if it is small enough
+
+  @details
+  Looking up short keys of fixed size records in a hash is cheaper than
+  going through the HEAP table handler. The temporary table is then not
+  opened, only its record buffer and fields are used.
+  The hash compares the key images as bytes, so it is used only when all
+  the key parts have fixed length (the bytes after a VARCHAR value in its
+  key image are not defined) and compare as binary.
+
+  @retval FALSE OK (the hash may be not used)
+  @retval TRUE  Error
+*/
+
+bool Expression_cache_tmptable::init_hash()
+{
+  KEY *key_info= cache_table->key_info;
+  if (ref.key_length > EXPCACHE_MAX_HASH_KEY_LENGTH ||
+      cache_table->s->blob_fields)
+    return FALSE;
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    KEY_PART_INFO *key_part= key_info->key_part + i;
+    if ((key_part->key_part_flag & (HA_VAR_LENGTH_PART | HA_BLOB_PART)) ||
+        !key_part->field->eq_cmp_as_binary())
+      return FALSE;
+  }
+  init_sql_alloc(PSI_INSTRUMENT_ME, &hash_root, 4096, 0,
+                 MYF(MY_THREAD_SPECIFIC));
+  if (my_hash_init(PSI_INSTRUMENT_ME, &hash, &my_charset_bin, 32, 0,
+                   ref.key_length, NULL, NULL, HASH_THREAD_SPECIFIC))
+  {
+    free_root(&hash_root, MYF(0));
+    return TRUE;
+  }
+  hash_size= 0;
+  hash_have_key= FALSE;
+  use_hash= TRUE;
+  /* Count it as the temporary table it replaces */
+  table_thd->inc_status_created_tmp_tables();
+  return FALSE;
+}
+
+
 /**
   Check if a given set of parameters of the expression is in the cache
 
@@ -214,6 +276,8 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
   int res;
   DBUG_ENTER("Expression_cache_tmptable::check_value");
 
+  if (use_hash)
+    DBUG_RETURN(check_hash(value));
   if (cache_table)
   {
     DBUG_PRINT("info", ("status: %u  has_record %u",
@@ -243,6 +307,120 @@ Expression_cache::result Expression_cache_tmptable::check_value(Item **value)
 }
 
 
+/**
+  Check if a given set of parameters of the expression is in the hash
+
+  @details
+  The same as check_value() for a cache kept in a hash. The key image is
+  built in ref.key_buff, where put_hash() finds it on a miss.
+  The data bytes of NULL key parts are cleared, so that NULL parameters
+  match each other as they do in the HEAP table index.
+  Handler_read_key is counted the same as join_read_key2() does for the
+  table, that is, only when the key differs from the previous one.
+*/
+
+Expression_cache::result Expression_cache_tmptable::check_hash(Item **value)
+{
+  uchar *entry;
+  bool have_prev_key= hash_have_key && !ref.key_err;
+  DBUG_ENTER("Expression_cache_tmptable::check_hash");
+
+  if (have_prev_key)
+    memcpy(ref.key_buff2, ref.key_buff, ref.key_length);
+  if (!(ref.key_err= cp_buffer_from_ref(table_thd, cache_table, &ref)))
+  {
+    KEY *key_info= cache_table->key_info;
+    uchar *key_pos= ref.key_buff;
+    for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+    {
+      KEY_PART_INFO *key_part= key_info->key_part + i;
+      if (key_part->null_bit && *key_pos)
+        bzero(key_pos + 1, key_part->store_length - 1);
+      key_pos+= key_part->store_length;
+    }
+    if (!have_prev_key ||
+        memcmp(ref.key_buff2, ref.key_buff, ref.key_length))
+    {
+      status_var_increment(table_thd->status_var.ha_read_key_count);
+      table_thd->check_limit_rows_examined();
+    }
+    hash_have_key= TRUE;
+  }
+  if (!ref.key_err &&
+      (entry= my_hash_search(&hash, ref.key_buff, ref.key_length)))
+  {
+    hit++;
+    memcpy(cache_table->record[0], entry + ref.key_length,
+           cache_table->s->reclength);
+    *value= cached_result;
+    DBUG_RETURN(Expression_cache::HIT);
+  }
+  if (((++miss) == EXPCACHE_CHECK_HIT_RATIO_AFTER) &&
+      ((double)hit / ((double)hit + miss)) <
+      EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+  {
+    DBUG_PRINT("info",
+               ("Early check: hit rate is not so good to keep the cache"));
+    disable_cache();
+  }
+  DBUG_RETURN(MISS);
+}
+
+
+/**
+  Put the record of the cache table into the hash
+
+  @details
+  When the hash grows over the limit of in-memory temporary tables the
+  cache is switched off or emptied depending on the hit rate, the same
+  as when its HEAP table is full. The cache kept in a hash is never moved
+  to disk. Handler_tmp_write is counted as for the writes to the table.
+
+  @retval FALSE OK
+  @retval TRUE  Error
+*/
+
+my_bool Expression_cache_tmptable::put_hash()
+{
+  uchar *entry;
+  size_t length= ref.key_length + cache_table->s->reclength;
+  DBUG_ENTER("Expression_cache_tmptable::put_hash");
+
+  /* The key could not be built, it is never looked up, see check_hash() */
+  if (ref.key_err)
+    DBUG_RETURN(FALSE);
+
+  status_var_increment(table_thd->status_var.ha_tmp_write_count);
+  if (hash_size + length >
+      MY_MIN(table_thd->variables.tmp_memory_table_size,
+             table_thd->variables.max_heap_table_size))
+  {
+    double hit_rate= ((double)hit / ((double)hit + miss));
+    if (hit_rate < EXPCACHE_MIN_HIT_RATE_FOR_MEM_TABLE)
+    {
+      DBUG_PRINT("info", ("hit rate is not so good to keep the cache"));
+      disable_cache();
+      DBUG_RETURN(FALSE);
+    }
+    DBUG_PRINT("info", ("hash is full, emptying it"));
+    status_var_increment(table_thd->status_var.ha_tmp_write_count);
+    my_hash_reset(&hash);
+    free_root(&hash_root, MYF(MY_MARK_BLOCKS_FREE));
+    hash_size= 0;
+  }
+
+  if (!(entry= (uchar*) alloc_root(&hash_root, length)))
+    DBUG_RETURN(TRUE);
+  memcpy(entry, ref.key_buff, ref.key_length);
+  memcpy(entry + ref.key_length, cache_table->record[0],
+         cache_table->s->reclength);
+  if (my_hash_insert(&hash, entry))
+    DBUG_RETURN(TRUE);
+  hash_size+= length;
+  DBUG_RETURN(FALSE);
+}
+
+
 /**
   Put a new entry into the expression cache
 
@@ -273,6 +451,13 @@ my_bool Expression_cache_tmptable::put_value(Item *value)
   if (unlikely(table_thd->is_error()))
     goto err;;
 
+  if (use_hash)
+  {
+    if (put_hash())
+      goto err;
+    DBUG_RETURN(FALSE);
+  }
+
   if (unlikely((error=
                 cache_table->file->ha_write_tmp_row(cache_table->record[0]))))
   {
@@ -18,6 +18,7 @@
 #define SQL_EXPRESSION_CACHE_INCLUDED
 
 #include "sql_select.h"
+#include "hash.h"
 
 
 /**
@@ -133,6 +134,9 @@ class Expression_cache_tmptable :public Expression_cache
 
 private:
   void disable_cache();
+  bool init_hash();
+  result check_hash(Item **value);
+  my_bool put_hash();
 
   /* tmp table parameters */
   TMP_TABLE_PARAM cache_table_param;
@@ -152,6 +156,19 @@ class Expression_cache_tmptable :public Expression_cache
   Item *val;
   /* hit/miss counters */
   ulong hit, miss;
+  /*
+    Entries of the cache when it is kept in a hash in memory instead of
+    the temporary table: the key image followed by the record of the
+    table. The table then is used only for its record and fields.
+  */
+  HASH hash;
+  MEM_ROOT hash_root;
+  /* Memory taken by the entries of the hash */
+  size_t hash_size;
+  /* Set on if ref.key_buff holds the key of a previous lookup */
+  bool hash_have_key;
+  /* Set on if the entries are kept in the hash */
+  bool use_hash;
   /* Set on if the object has been successfully initialized with init() */
   bool inited;
 };
@@ -32,9 +32,16 @@
 #include "sql_base.h"
 #include "sql_select.h"
 #include "opt_subselect.h"
+#include "my_bit.h"
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
+/* Parameters of the Bloom filters of the BNLH join caches */
+#define BLOOM_FILTER_BITS_PER_KEY       8
+#define BLOOM_FILTER_MAX_BITS           (1UL << 23)
+#define BLOOM_FILTER_CHECK_INTERVAL     1024
+#define BLOOM_FILTER_MIN_REJECT_RATE    8
+
 static void save_or_restore_used_tabs(JOIN_TAB *join_tab, bool save);
 
 /*****************************************************************************
@@ -2688,6 +2695,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
 
   hash_table= 0;
   key_entries= 0;
+  bloom_filter= 0;
 
   key_length= ref->key_length;
 
@@ -2704,7 +2712,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   ref_key_info= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
   ref_used_key_parts= join_tab->ref.key_parts;
 
-  hash_func= &JOIN_CACHE_HASHED::get_hash_idx_simple;
+  hash_func= &JOIN_CACHE_HASHED::get_hash_value_simple;
   hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_simple;
 
   KEY_PART_INFO *key_part= ref_key_info->key_part;
@@ -2713,7 +2721,7 @@ int JOIN_CACHE_HASHED::init(bool for_explain)
   {
     if (!key_part->field->eq_cmp_as_binary())
     {
-      hash_func= &JOIN_CACHE_HASHED::get_hash_idx_complex;
+      hash_func= &JOIN_CACHE_HASHED::get_hash_value_complex;
       hash_cmp_func= &JOIN_CACHE_HASHED::equal_keys_complex;
       break;
     }
@@ -2988,6 +2996,8 @@ bool JOIN_CACHE_HASHED::put_record()
     DBUG_ASSERT(last_key_entry >= end_pos);
     /* Increment the counter of key_entries in the hash table */ 
     key_entries++;
+    if (bloom_filter)
+      bloom_filter_add((this->*hash_func)(key, key_len));
   }  
   return is_full;
 }
@@ -3103,7 +3113,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
                                    uchar **key_ref_ptr) 
 {
   bool is_found= FALSE;
-  uint idx= (this->*hash_func)(key, key_length);
+  uint idx= (uint) ((this->*hash_func)(key, key_length) % hash_entries);
   uchar *ref_ptr= hash_table+size_of_key_ofs*idx;
   while (!is_null_key_ref(ref_ptr))
   {
@@ -3127,21 +3137,22 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
   Hash function that considers a key in the hash table as byte array
 
   SYNOPSIS
-    get_hash_idx_simple()
+    get_hash_value_simple()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It considers the key just as
-    a sequence of bytes of the length key_len.
+    The function calculates the hash value for the given key. The index
+    of the hash entry in the hash table of the join buffer is this value
+    modulo hash_entries. The function considers the key just as a sequence
+    of bytes of the length key_len.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_value_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3152,7 +3163,7 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
 }
 
 
@@ -3160,13 +3171,14 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
   Hash function that takes into account collations of the components of the key  
 
   SYNOPSIS
-    get_hash_idx_complex()
+    get_hash_value_complex()
       key             pointer to the key value
       key_len         key value length
       
   DESCRIPTION
-    The function calculates an index of the hash entry in the hash table
-    of the join buffer for the given key. It takes into account that the
+    The function calculates the hash value for the given key. The index
+    of the hash entry in the hash table of the join buffer is this value
+    modulo hash_entries. It takes into account that the
     components of the key may be of a varchar type with different collations.
     The function guarantees that the same hash value for any two equal
     keys that may differ as byte sequences.
@@ -3176,14 +3188,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     operation.
 
   RETURN VALUE
-    the calculated index of the hash entry for the given key  
+    the calculated hash value for the given key  
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_value_complex(uchar *key, uint key_len)
 {
-  return 
-    (uint) (key_hashnr(ref_key_info, ref_used_key_parts, key) % hash_entries);
+  return key_hashnr(ref_key_info, ref_used_key_parts, key);
 }
 
 
@@ -3264,6 +3275,10 @@ void JOIN_CACHE_HASHED:: cleanup_hash_table()
   last_key_entry= hash_table;
   bzero(hash_table, (buff+buff_size)-hash_table);
   key_entries= 0;
+  if (bloom_filter)
+    bzero(bloom_filter, (bloom_filter_mask+1)/8);
+  bloom_filter_off= FALSE;
+  bloom_filter_probes= bloom_filter_rejects= 0;
 }
 
 
@@ -3398,13 +3413,26 @@ int JOIN_TAB_SCAN::next()
     join_tab->tracker->r_rows++;
   }
 
-  while (!err && select && (skip_rc= select->skip_record(thd)) <= 0)
+  while (!err)
   {
-    if (unlikely(thd->check_killed()) || skip_rc < 0)
+    if (cache->skip_probe_record())
+    {
+      /* The condition is not checked, so keep the row out of r_filtered */
+      join_tab->tracker->on_record_skipped();
+    }
+    else
+    {
+      if (!select || (skip_rc= select->skip_record(thd)) > 0)
+        break;
+      if (skip_rc < 0)
+        return 1;
+    }
+    if (unlikely(thd->check_killed()))
       return 1;
     /* 
-      Move to the next record if the last retrieved record does not
-      meet the condition pushed to the table join_tab.
+      Move to the next record if the last retrieved record cannot match
+      any record from the join buffer or does not meet the condition
+      pushed to the table join_tab.
     */
     err= info->read_record();
     if (!err)
@@ -3661,7 +3689,9 @@ uchar *JOIN_CACHE_BNLH::get_matching_chain_by_join_key()
   TABLE_REF *ref= &join_tab->ref;
   KEY *keyinfo= join_tab->get_keyinfo_by_key_no(ref->key);
   /* Build the join key value out of the record in the record buffer */
-  key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+  if (!join_key_is_built)
+    key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+  join_key_is_built= FALSE;
   /* Look for this key in the join buffer */
   if (!key_search(key_buff, key_length, &key_ref_ptr))
     return 0;
@@ -3813,12 +3843,70 @@ void JOIN_CACHE_BNLH::read_next_candidate_for_match(uchar *rec_ptr)
 
 int JOIN_CACHE_BNLH::init(bool for_explain)
 {
+  int rc;
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
-  DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
+  join_key_is_built= FALSE;
+  if ((rc= JOIN_CACHE_HASHED::init(for_explain)) || for_explain)
+    DBUG_RETURN(rc);
+
+  /* Use about BLOOM_FILTER_BITS_PER_KEY bits of the filter per hash entry */
+  ulonglong bits= (ulonglong) hash_entries * BLOOM_FILTER_BITS_PER_KEY;
+  set_if_bigger(bits, 64);
+  set_if_smaller(bits, BLOOM_FILTER_MAX_BITS);
+  bloom_filter_mask= my_round_up_to_next_power((uint32) bits) - 1;
+  if (!(bloom_filter= (uchar*) join->thd->calloc((bloom_filter_mask+1)/8)))
+    DBUG_RETURN(1);
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Check with the Bloom filter whether a record of join_tab can have matches
+
+  SYNOPSIS
+    skip_probe_record()
+
+  DESCRIPTION
+    This implementation of the virtual function skip_probe_record builds
+    the join key for the record of join_tab in the record buffer and looks
+    for it in the Bloom filter built over the keys of the hash table.
+    The record is skipped if the key is not there, so neither the condition
+    pushed to join_tab is evaluated nor the hash table is probed for it.
+    The built key is reused by get_matching_chain_by_join_key().
+    The filter is turned off until the join buffer is refilled if less
+    than one of BLOOM_FILTER_MIN_REJECT_RATE records is skipped with it.
+
+  RETURN VALUE
+    TRUE    the record cannot match any record in the join buffer
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::skip_probe_record()
+{
+  join_key_is_built= FALSE;
+  if (!bloom_filter || bloom_filter_off)
+    return FALSE;
+
+  TABLE_REF *ref= &join_tab->ref;
+  KEY *keyinfo= join_tab->get_keyinfo_by_key_no(ref->key);
+  key_copy(key_buff, join_tab->table->record[0], keyinfo, key_length, TRUE);
+  join_key_is_built= TRUE;
+
+  bloom_filter_probes++;
+  if (!bloom_filter_may_contain((this->*hash_func)(key_buff, key_length)))
+  {
+    bloom_filter_rejects++;
+    join_key_is_built= FALSE;
+    return TRUE;
+  }
+  if (bloom_filter_probes % BLOOM_FILTER_CHECK_INTERVAL == 0 &&
+      bloom_filter_rejects * BLOOM_FILTER_MIN_REJECT_RATE < bloom_filter_probes)
+    bloom_filter_off= TRUE;
+  return FALSE;
 }
 
 
@@ -488,6 +488,13 @@ class JOIN_CACHE :public Sql_alloc
     match the record of the joined table read into the record buffer
   */ 
   virtual bool prepare_look_for_matches(bool skip_last)= 0;
+  /*
+    Check whether the record of the joined table read into the record buffer
+    cannot match any record from the join buffer. An implementation may
+    answer FALSE when it cannot tell it cheaper than by looking for the
+    matches.
+  */
+  virtual bool skip_probe_record() { return FALSE; }
   /* 
     Shall return a pointer to the record from join buffer that is checked
     as the next candidate for a match with the current record from join_tab.
@@ -763,7 +770,7 @@ class JOIN_CACHE :public Sql_alloc
 class JOIN_CACHE_HASHED: public JOIN_CACHE
 {
 
-  typedef uint (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
+  typedef ulong (JOIN_CACHE_HASHED::*Hash_func) (uchar *key, uint key_len);
   typedef bool (JOIN_CACHE_HASHED::*Hash_cmp_func) (uchar *key1, uchar *key2,
                                                     uint key_len);
   
@@ -791,8 +798,8 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
-  inline uint get_hash_idx_simple(uchar *key, uint key_len);
-  inline uint get_hash_idx_complex(uchar *key, uint key_len);
+  inline ulong get_hash_value_simple(uchar *key, uint key_len);
+  inline ulong get_hash_value_complex(uchar *key, uint key_len);
 
   inline bool equal_keys_simple(uchar *key1, uchar *key2, uint key_len);
   inline bool equal_keys_complex(uchar *key1, uchar *key2, uint key_len);
@@ -835,6 +842,47 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Number of key entries in the hash table (number of distinct keys) */
   uint key_entries;
 
+  /*
+    A Bloom filter over the keys in the hash table: a bitmap that has
+    bloom_filter_mask+1 bits, the number being a power of 2.
+    It is NULL if the cache does not use a filter.
+  */
+  uchar *bloom_filter;
+  ulong bloom_filter_mask;
+  /*
+    TRUE if the filter rejected too few records to be worth the lookups.
+    The filter is still filled, and is tried again when the buffer is
+    refilled.
+  */
+  bool bloom_filter_off;
+  /* Number of lookups in the Bloom filter and how many of them failed */
+  ha_rows bloom_filter_probes;
+  ha_rows bloom_filter_rejects;
+
+  /* The second bit of the Bloom filter set for a key with hash value 'nr' */
+  static ulong bloom_filter_hash2(ulong nr)
+  {
+    return (nr >> 16) ^ (nr * 0x9E3779B1UL);
+  }
+
+  /* Add a key with the hash value 'nr' to the Bloom filter */
+  void bloom_filter_add(ulong nr)
+  {
+    ulong bit1= nr & bloom_filter_mask;
+    ulong bit2= bloom_filter_hash2(nr) & bloom_filter_mask;
+    bloom_filter[bit1 / 8]|= (uchar) (1 << (bit1 % 8));
+    bloom_filter[bit2 / 8]|= (uchar) (1 << (bit2 % 8));
+  }
+
+  /* Check whether a key with the hash value 'nr' may be in the filter */
+  bool bloom_filter_may_contain(ulong nr)
+  {
+    ulong bit1= nr & bloom_filter_mask;
+    ulong bit2= bloom_filter_hash2(nr) & bloom_filter_mask;
+    return (bloom_filter[bit1 / 8] & (1 << (bit1 % 8))) &&
+           (bloom_filter[bit2 / 8] & (1 << (bit2 % 8)));
+  }
+
   /* The position of the last key entry in the hash table */
   uchar *last_key_entry;
 
@@ -1164,6 +1212,12 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
   */
   uchar *next_matching_rec_ref_ptr;
 
+  /*
+    TRUE if key_buff contains the join key of the record of join_tab
+    in the record buffer, as built by skip_probe_record()
+  */
+  bool join_key_is_built;
+
   /*
     Get the chain of records from buffer matching the current candidate
     record for join
@@ -1172,6 +1226,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool prepare_look_for_matches(bool skip_last);
 
+  bool skip_probe_record();
+
   uchar *get_next_candidate_for_match();
 
   bool skip_next_candidate_for_match(uchar *rec_ptr);
@@ -3028,6 +3028,8 @@ void st_select_lex::init_select()
   in_tvc= false;
   versioned_tables= 0;
   nest_flags= 0;
+  saved_join_order= 0;
+  saved_join_order_length= saved_join_order_size= 0;
 }
 
 /*
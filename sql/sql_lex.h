@@ -1224,6 +1224,14 @@ class st_select_lex: public st_select_lex_node
       3) Fields in the ORDER BY clause
   */
   uint fields_in_window_functions;
+  /*
+    Join order chosen by the first optimization of this select in a
+    prepared statement or stored program, reused by the next executions
+    when optimizer_reuse_join_order is set (see choose_plan()).
+    Allocated on the statement arena.
+  */
+  TABLE_LIST **saved_join_order;
+  uint saved_join_order_length, saved_join_order_size;
   enum_parsing_place parsing_place; /* where we are parsing expression */
   enum_parsing_place save_parsing_place;
   enum_parsing_place context_analysis_place; /* where we are in prepare */
@@ -1158,6 +1158,12 @@ static enum enum_server_command fetch_command(THD *thd, char *packet)
   DBUG_RETURN(command);
 }
 
+/*
+  Number of commands in a row that must send less than net_buffer_length
+  before a grown NET buffer is shrunk again, see do_command()
+*/
+#define NET_SHRINK_AFTER_SMALL_COMMANDS 4
+
 /**
   Read one command from connection and execute it (query or simple command).
   This function is called in loop from thread function.
@@ -1199,8 +1205,34 @@ bool do_command(THD *thd)
 
   net_new_transaction(net);
 
+  /*
+    If the previous command sent more than a couple of NET buffers, the
+    connection is likely to fetch large results. Let the buffer grow, so
+    that these are sent with fewer and larger writes. Once a few commands
+    in a row have sent less than net_buffer_length, the large buffer is
+    no longer worth its memory and gets its original size back.
+  */
+  {
+    ulonglong sent= (thd->status_var.bytes_sent > thd->start_bytes_sent ?
+                     thd->status_var.bytes_sent - thd->start_bytes_sent : 0);
+    if (sent > 2 * (ulonglong) net->max_packet)
+    {
+      thd->net_small_commands= 0;
+      net_grow_write_buffer(net);
+    }
+    else if (sent > thd->variables.net_buffer_length)
+      thd->net_small_commands= 0;
+    else if (net->max_packet > thd->variables.net_buffer_length &&
+             ++thd->net_small_commands >= NET_SHRINK_AFTER_SMALL_COMMANDS)
+    {
+      thd->net_small_commands= 0;
+      net_shrink_write_buffer(net, thd->variables.net_buffer_length);
+    }
+  }
+
   /* Save for user statistics */
   thd->start_bytes_received= thd->status_var.bytes_received;
+  thd->start_bytes_sent= thd->status_var.bytes_sent;
 
   /*
     Synchronization point for testing of KILL_CONNECTION.
@@ -2322,6 +2354,17 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
   if (drop_more_results)
     thd->server_status&= ~SERVER_MORE_RESULTS_EXISTS;
 
+#ifndef EMBEDDED_LIBRARY
+  /*
+    Replies held back by net_flush_reply() go out with the reply to the
+    next command. Unless that command is already buffered, send them now,
+    so that they do not wait for a command that may never come.
+  */
+  if (unlikely(thd->net_deferred_output.length()) &&
+      (error || !thd->net.vio || !thd->net.vio->has_data(thd->net.vio)))
+    net_flush(&thd->net);
+#endif
+
   if (likely(!thd->is_error() && !thd->killed_errno()))
     mysql_audit_general(thd, MYSQL_AUDIT_GENERAL_RESULT, 0, 0);
 
@@ -2353,7 +2396,7 @@ bool dispatch_command(enum enum_server_command command, THD *thd,
     Unlink it now, before freeing the root.
   */
   thd->lex->m_sql_cmd= NULL;
-  free_root(thd->mem_root,MYF(MY_KEEP_PREALLOC));
+  free_root_keep(thd->mem_root, thd->variables.query_alloc_keep_size);
 
 #if defined(ENABLED_PROFILING)
   thd->profiling.finish_current_query();
@@ -110,12 +110,14 @@ static void optimize_straight_join(JOIN *join, table_map join_tables);
 static bool greedy_search(JOIN *join, table_map remaining_tables,
                           uint depth, uint prune_level,
                           uint use_cond_selectivity);
+struct Join_prefix_cost;
 static bool best_extension_by_limited_search(JOIN *join,
                                              table_map remaining_tables,
                                              uint idx, double record_count,
                                              double read_time, uint depth,
                                              uint prune_level,
-                                             uint use_cond_selectivity);
+                                             uint use_cond_selectivity,
+                                             Join_prefix_cost *prefix_costs);
 static uint determine_search_depth(JOIN* join);
 C_MODE_START
 static int join_tab_cmp(const void *dummy, const void* ptr1, const void* ptr2);
@@ -4240,6 +4242,107 @@ bool JOIN::save_explain_data(Explain_query *output, bool can_overwrite,
 }
 
 
+/*
+  Ratio between the rows read per scan of a table and the estimate of the
+  plan above which JOIN::check_cardinality_estimates() reports the table
+*/
+#define CARDINALITY_MISESTIMATE_RATIO 1000.0
+
+static bool is_cardinality_misestimate(JOIN_TAB *tab)
+{
+  if (!tab->tracker || !tab->tracker->has_scans() || tab->filesort)
+    return false;
+  /*
+    FirstMatch, LooseScan and the "Not exists" optimization stop reading
+    the table before the end of the scan, the rows read tell nothing
+    about the estimate
+  */
+  if (tab->check_only_first_match() || tab->loosescan_match_tab ||
+      tab->table->reginfo.not_exists_optimize)
+    return false;
+  double estimated= MY_MAX(tab->records_read, 1.0);
+  double observed= MY_MAX(tab->tracker->get_avg_rows(), 1.0);
+  return (observed >= estimated * CARDINALITY_MISESTIMATE_RATIO ||
+          estimated >= observed * CARDINALITY_MISESTIMATE_RATIO);
+}
+
+
+/**
+  Compare the rows read from the tables of the join with the estimates
+
+  @details
+    This is a checkpoint after the first execution of the join in the
+    statement: for each top-level table that was scanned, the average
+    number of rows read per scan is compared with records_read of the plan.
+    For a derived table this is the number of rows it was materialized
+    with. Tables whose scan was cut short, either by LIMIT (which includes
+    the implicit LIMIT 1 of EXISTS) or by a first-match strategy, are not
+    checked. A table whose estimate was off by more than
+    CARDINALITY_MISESTIMATE_RATIO in either direction
+     - is marked as r_cardinality_misestimate in ANALYZE FORMAT=JSON,
+     - is listed in the optimizer trace,
+     - makes the join order saved for optimizer_reuse_join_order to be
+       dropped, so that the next execution searches for the join order
+       again.
+*/
+
+void JOIN::check_cardinality_estimates()
+{
+  JOIN_TAB *tab;
+  bool misestimated= false;
+  DBUG_ENTER("JOIN::check_cardinality_estimates");
+
+  if (cardinality_checked || !explain || !explain->join_tabs ||
+      thd->is_error() ||
+      !(thd->lex->analyze_stmt || thd->trace_started() ||
+        select_lex->saved_join_order_length))
+    DBUG_VOID_RETURN;
+  cardinality_checked= true;
+
+  /* The execution stopped when LIMIT was reached */
+  if (send_records >= unit->lim.get_select_limit())
+    DBUG_VOID_RETURN;
+
+  for (tab= first_top_level_tab(this, WITHOUT_CONST_TABLES); tab;
+       tab= next_top_level_tab(this, tab))
+  {
+    if (!is_cardinality_misestimate(tab))
+      continue;
+    misestimated= true;
+    for (uint i= 0; i < explain->n_join_tabs; i++)
+    {
+      if (&explain->join_tabs[i]->tracker == tab->tracker)
+        explain->join_tabs[i]->r_cardinality_misestimate= true;
+    }
+  }
+  if (!misestimated)
+    DBUG_VOID_RETURN;
+
+  Json_writer_object trace_wrapper(thd);
+  Json_writer_object trace_checkpoint(thd, "cardinality_checkpoint");
+  trace_checkpoint.add_select_number(select_lex->select_number);
+  {
+    Json_writer_array trace_tables(thd, "misestimated_tables");
+    for (tab= first_top_level_tab(this, WITHOUT_CONST_TABLES); tab;
+         tab= next_top_level_tab(this, tab))
+    {
+      if (!is_cardinality_misestimate(tab))
+        continue;
+      Json_writer_object trace_tab(thd);
+      trace_tab.add_table_name(tab).
+        add("estimated_rows", tab->records_read).
+        add("observed_rows", tab->tracker->get_avg_rows());
+    }
+  }
+  if (select_lex->saved_join_order_length)
+  {
+    select_lex->saved_join_order_length= 0;
+    trace_checkpoint.add("saved_join_order_dropped", true);
+  }
+  DBUG_VOID_RETURN;
+}
+
+
 void JOIN::exec()
 {
   DBUG_EXECUTE_IF("show_explain_probe_join_exec_start", 
@@ -4251,6 +4354,7 @@ void JOIN::exec()
   ANALYZE_START_TRACKING(thd, &explain->time_tracker);
   exec_inner();
   ANALYZE_STOP_TRACKING(thd, &explain->time_tracker);
+  check_cardinality_estimates();
 
   DBUG_EXECUTE_IF("show_explain_probe_join_exec_end", 
                   if (dbug_user_var_equals_int(thd, 
@@ -5958,6 +6062,18 @@ add_key_field(JOIN *join,
       {
         stat[0].const_keys.merge(possible_keys);
         bitmap_set_bit(&field->table->cond_set, field->field_index);
+        /*
+          A skip scan can use the indexes where the field is not the first
+          key part, so let the range optimizer look at them as well. Like
+          for add_group_and_distinct_keys(), they are not possible keys
+          for ref access.
+        */
+        if (optimizer_flag(join->thd, OPTIMIZER_SWITCH_SKIP_SCAN))
+        {
+          key_map skip_scan_keys= field->part_of_key;
+          skip_scan_keys.intersect(field->table->keys_in_use_for_query);
+          stat[0].const_keys.merge(skip_scan_keys);
+        }
       }
       else if (!eq_func)
       {
@@ -8234,6 +8350,78 @@ static void choose_initial_table_order(JOIN *join)
 }
 
 
+/**
+  Put the tables in the join order saved by an earlier execution.
+
+  @param join  the join being optimized
+
+  @details
+    The saved order is used only if it has exactly the tables that are left
+    to be joined: depending on the parameter values a table may become
+    const in one execution and not in another one. join->best_ref is left
+    untouched if the order cannot be used.
+
+  @retval TRUE   join->best_ref is in the saved order
+  @retval FALSE  the join order has to be searched for
+*/
+
+static bool restore_saved_join_order(JOIN *join)
+{
+  SELECT_LEX *sl= join->select_lex;
+  JOIN_TAB **ref= join->best_ref + join->const_tables;
+  uint n= join->table_count - join->const_tables;
+  JOIN_TAB *order[MAX_TABLES];
+
+  if (!sl->saved_join_order || sl->saved_join_order_length != n)
+    return FALSE;
+  for (uint i= 0; i < n; i++)
+  {
+    uint j;
+    for (j= 0; j < n; j++)
+    {
+      if (ref[j]->table->pos_in_table_list == sl->saved_join_order[i])
+        break;
+    }
+    if (j == n)
+      return FALSE;
+    order[i]= ref[j];
+  }
+  memcpy(ref, order, sizeof(JOIN_TAB*) * n);
+  return TRUE;
+}
+
+
+/**
+  Save the join order found by choose_plan() for the next executions of
+  the statement.
+*/
+
+static void save_join_order(JOIN *join)
+{
+  THD *thd= join->thd;
+  SELECT_LEX *sl= join->select_lex;
+  uint n= join->table_count - join->const_tables;
+
+  if (!sl->saved_join_order)
+  {
+    Query_arena_stmt on_stmt_arena(thd);
+    if (!(sl->saved_join_order=
+            (TABLE_LIST**) thd->alloc(sizeof(TABLE_LIST*) * join->table_count)))
+      return;
+    sl->saved_join_order_size= join->table_count;
+  }
+  if (n > sl->saved_join_order_size)
+  {
+    sl->saved_join_order_length= 0;
+    return;
+  }
+  for (uint i= 0; i < n; i++)
+    sl->saved_join_order[i]=
+      join->best_positions[join->const_tables + i].table->table->pos_in_table_list;
+  sl->saved_join_order_length= n;
+}
+
+
 /**
   Selects and invokes a search strategy for an optimal query plan.
 
@@ -8262,6 +8450,14 @@ choose_plan(JOIN *join, table_map join_tables)
          join->thd->variables.optimizer_use_condition_selectivity;
   bool straight_join= MY_TEST(join->select_options & SELECT_STRAIGHT_JOIN);
   THD *thd= join->thd;
+  /*
+    Prepared statements and statements of stored programs may reuse the
+    join order of their previous execution. Semi-join materialization nests
+    are optimized anew, as part of each search.
+  */
+  bool reuse_join_order= thd->variables.optimizer_reuse_join_order &&
+                         !straight_join && !join->emb_sjm_nest &&
+                         !thd->stmt_arena->is_conventional();
   DBUG_ENTER("choose_plan");
 
   join->cur_embedding_map= 0;
@@ -8298,16 +8494,19 @@ choose_plan(JOIN *join, table_map join_tables)
             join->table_count - join->const_tables, sizeof(JOIN_TAB*),
             jtab_sort_func, (void*)join->emb_sjm_nest);
 
-  Json_writer_object wrapper(thd);
-  Json_writer_array trace_plan(thd,"considered_execution_plans");
-
   if (!join->emb_sjm_nest)
   {
     choose_initial_table_order(join);
   }
   join->cur_sj_inner_tables= 0;
 
-  if (straight_join)
+  bool reused= reuse_join_order && restore_saved_join_order(join);
+  Json_writer_object wrapper(thd);
+  if (reused)
+    wrapper.add("reused_join_order", true);
+  Json_writer_array trace_plan(thd,"considered_execution_plans");
+
+  if (straight_join || reused)
   {
     optimize_straight_join(join, join_tables);
   }
@@ -8320,6 +8519,8 @@ choose_plan(JOIN *join, table_map join_tables)
     if (greedy_search(join, join_tables, search_depth, prune_level,
                       use_cond_selectivity))
       DBUG_RETURN(TRUE);
+    if (reuse_join_order)
+      save_join_order(join);
   }
 
   /* 
@@ -8640,6 +8841,70 @@ optimize_straight_join(JOIN *join, table_map join_tables)
 }
 
 
+/*
+  The cheapest expanded partial plan found for a set of tables, used to skip
+  partial plans that join the same tables at a higher cost.
+
+  The cost of completing a partial plan depends on which tables it has
+  joined and on its cardinality, but not on the order of those tables.
+  The exception is the cost of sorting, which is paid unless the first
+  table provides the ordering, so this is remembered as well.
+  The entries form a direct mapped cache: a colliding set of tables
+  replaces the entry, which only loses the chance to prune.
+*/
+
+struct Join_prefix_cost
+{
+  table_map remaining_tables;
+  double read_time;
+  double record_count;
+  bool sort_needed;
+};
+
+/* Number of tables a join needs to have for Join_prefix_cost to be used */
+#define PREFIX_COST_MIN_TABLES 8
+/* Number of Join_prefix_cost entries, must be a power of 2 */
+#define PREFIX_COST_SIZE 4096
+
+
+/**
+  Check whether a partial plan is no better than an already expanded
+  partial plan with the same tables, and remember it otherwise.
+
+  @param join              the join being optimized
+  @param prefix_costs      the costs of expanded partial plans
+  @param remaining_tables  tables not in the partial plan
+  @param read_time         cost of the partial plan
+  @param record_count      cardinality of the partial plan
+
+  @retval TRUE   the partial plan does not need to be expanded
+  @retval FALSE  the partial plan has been remembered
+*/
+
+static bool check_prefix_cost(JOIN *join, Join_prefix_cost *prefix_costs,
+                              table_map remaining_tables,
+                              double read_time, double record_count)
+{
+  bool sort_needed= join->sort_by_table &&
+                    join->sort_by_table !=
+                    join->positions[join->const_tables].table->table;
+  ulonglong hash= (ulonglong) remaining_tables * 0x9E3779B97F4A7C15ULL;
+  Join_prefix_cost *entry= prefix_costs +
+    (uint) (hash >> 32) % PREFIX_COST_SIZE;
+
+  if (entry->remaining_tables == remaining_tables &&
+      entry->read_time <= read_time &&
+      entry->record_count <= record_count &&
+      (!entry->sort_needed || sort_needed))
+    return TRUE;
+  entry->remaining_tables= remaining_tables;
+  entry->read_time= read_time;
+  entry->record_count= record_count;
+  entry->sort_needed= sort_needed;
+  return FALSE;
+}
+
+
 /**
   Find a good, possibly optimal, query execution plan (QEP) by a greedy search.
 
@@ -8708,6 +8973,15 @@ optimize_straight_join(JOIN *join, table_map join_tables)
     In the future, 'greedy_search' might be extended to support other
     implementations of 'best_extension', e.g. some simpler quadratic procedure.
 
+  @par
+    For joins of at least PREFIX_COST_MIN_TABLES tables each step also
+    remembers the cheapest partial plans for the sets of tables it has
+    expanded, see Join_prefix_cost. A partial plan that joins the same
+    tables as an already expanded one, with no lower cost and cardinality,
+    is not expanded again. This makes the exhaustive search closer to
+    dynamic programming over table sets, and the search depth can be larger
+    for the same optimization time.
+
   @param join             pointer to the structure providing all context info
                           for the query
   @param remaining_tables set of tables not included into the partial plan yet
@@ -8739,6 +9013,7 @@ greedy_search(JOIN      *join,
   JOIN_TAB  *best_table; // the next plan node to be added to the curr QEP
   // ==join->tables or # tables in the sj-mat nest we're optimizing
   uint      n_tables __attribute__((unused));
+  Join_prefix_cost *prefix_costs= NULL;
   DBUG_ENTER("greedy_search");
 
   /* number of tables that remain to be optimized */
@@ -8749,12 +9024,27 @@ greedy_search(JOIN      *join,
                                          :
                                          ~(table_map)0));
 
+  /*
+    Semi-join strategies depend on the order of the tables in the partial
+    plan, not only on their set, so partial plans are not compared for them.
+  */
+  if (size_remain >= PREFIX_COST_MIN_TABLES && search_depth > 2 &&
+      !join->emb_sjm_nest && !join->select_lex->sj_nests.elements)
+  {
+    if (!(prefix_costs= (Join_prefix_cost*)
+            join->thd->alloc(sizeof(Join_prefix_cost) * PREFIX_COST_SIZE)))
+      DBUG_RETURN(TRUE);
+  }
+
   do {
     /* Find the extension of the current QEP with the lowest cost */
     join->best_read= DBL_MAX;
+    /* Costs of partial plans are only comparable within one step */
+    if (prefix_costs)
+      bzero(prefix_costs, sizeof(Join_prefix_cost) * PREFIX_COST_SIZE);
     if (best_extension_by_limited_search(join, remaining_tables, idx, record_count,
                                          read_time, search_depth, prune_level,
-                                         use_cond_selectivity))
+                                         use_cond_selectivity, prefix_costs))
       DBUG_RETURN(TRUE);
     /*
       'best_read < DBL_MAX' means that optimizer managed to find
@@ -9474,6 +9764,8 @@ double table_cond_selectivity(JOIN *join, uint idx, JOIN_TAB *s,
                           (values: 0 = EXHAUSTIVE, 1 = PRUNE_BY_TIME_OR_ROWS)
   @param use_cond_selectivity  specifies how the selectivity of the conditions
                           pushed to a table should be taken into account
+  @param prefix_costs     costs of the expanded partial plans, or NULL if
+                          partial plans are not compared (see greedy_search())
 
   @retval
     FALSE       ok
@@ -9489,7 +9781,8 @@ best_extension_by_limited_search(JOIN      *join,
                                  double    read_time,
                                  uint      search_depth,
                                  uint      prune_level,
-                                 uint      use_cond_selectivity)
+                                 uint      use_cond_selectivity,
+                                 Join_prefix_cost *prefix_costs)
 {
   DBUG_ENTER("best_extension_by_limited_search");
 
@@ -9633,6 +9926,21 @@ best_extension_by_limited_search(JOIN      *join,
                                         pushdown_cond_selectivity;
       if ( (search_depth > 1) && (remaining_tables & ~real_table_bit) & allowed_tables )
       { /* Recursively expand the current partial plan */
+        if (prefix_costs &&
+            check_prefix_cost(join, prefix_costs,
+                              remaining_tables & ~real_table_bit,
+                              current_read_time, partial_join_cardinality))
+        {
+          DBUG_EXECUTE("opt", print_plan(join, idx+1,
+                                         current_record_count,
+                                         read_time,
+                                         current_read_time,
+                                         "pruned_by_equivalent_prefix"););
+          trace_one_table.add("pruned_by_equivalent_prefix", true);
+          restore_prev_nj_state(s);
+          restore_prev_sj_state(remaining_tables, s, idx);
+          continue;
+        }
         swap_variables(JOIN_TAB*, join->best_ref[idx], *pos);
         Json_writer_array trace_rest(thd, "rest_of_plan");
         if (best_extension_by_limited_search(join,
@@ -9642,7 +9950,8 @@ best_extension_by_limited_search(JOIN      *join,
                                              current_read_time,
                                              search_depth - 1,
                                              prune_level,
-                                             use_cond_selectivity))
+                                             use_cond_selectivity,
+                                             prefix_costs))
           DBUG_RETURN(TRUE);
         swap_variables(JOIN_TAB*, join->best_ref[idx], *pos);
       }
@@ -18338,6 +18647,9 @@ TABLE *Create_tmp_table::start(THD *thd,
                         &tmpname, (uint) strlen(path)+1,
                         &m_group_buff, (m_group && ! m_using_unique_constraint ?
                                       param->group_length : 0),
+                        &param->last_group_buff,
+                        (m_group && ! m_using_unique_constraint ?
+                         param->group_length : 0),
                         &m_bitmaps, bitmap_buffer_size(field_count)*6,
                         &const_key_parts, sizeof(*const_key_parts),
                         NullS))
@@ -22085,12 +22397,16 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
 	   bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  TMP_TABLE_PARAM *const param= join_tab->tmp_table_param;
   ORDER   *group;
   int	  error;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    param->last_group_positioned= false;
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
 
   join->found_records++;
   copy_fields(join_tab->tmp_table_param);	// Groups are copied twice.
@@ -22112,8 +22428,18 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (item->maybe_null)
       group->buff[-1]= (char) group->field->is_null();
   }
-  if (!table->file->ha_index_read_map(table->record[1],
-                                      join_tab->tmp_table_param->group_buff,
+  /*
+    Rows of the same group often arrive one after another. If the
+    handler is still positioned on the group of the previous row and
+    record[1] holds its image, skip the index lookup. The keys are
+    compared bytewise, so a mismatch only means we do the lookup.
+  */
+  bool same_group= (param->last_group_positioned &&
+                    !memcmp(param->last_group_buff, param->group_buff,
+                            param->group_length));
+  if (same_group ||
+      !table->file->ha_index_read_map(table->record[1],
+                                      param->group_buff,
                                       HA_WHOLE_KEY,
                                       HA_READ_KEY_EXACT))
   {						/* Update old record */
@@ -22122,12 +22448,28 @@ end_update(JOIN *join, JOIN_TAB *join_tab __attribute__((unused)),
     if (unlikely((error= table->file->ha_update_tmp_row(table->record[1],
                                                         table->record[0]))))
     {
+      param->last_group_positioned= false;
       table->file->print_error(error,MYF(0));	/* purecov: inspected */
       DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
     }
+    /*
+      HEAP keeps its current row after heap_update(), other engines
+      (Aria, MyISAM) require a new positioning read.
+    */
+    if (table->s->db_type() == heap_hton)
+    {
+      store_record(table,record[1]);
+      if (!same_group)
+      {
+        memcpy(param->last_group_buff, param->group_buff,
+               param->group_length);
+        param->last_group_positioned= true;
+      }
+    }
     goto end;
   }
 
+  param->last_group_positioned= false;
   init_tmptable_sum_functions(join->sum_funcs);
   if (unlikely(copy_funcs(join_tab->tmp_table_param->items_to_copy,
                           join->thd)))
@@ -26759,9 +27101,11 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
         eta->push_extra(ET_USING_INDEX_FOR_GROUP_BY);
         eta->loose_scan_is_scanning= qgs->loose_scan_is_scanning();
       }
-      else
+      else if (quick_type != QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
         eta->push_extra(ET_USING_INDEX);
     }
+    if (quick_type == QUICK_SELECT_I::QS_TYPE_SKIP_SCAN)
+      eta->push_extra(ET_USING_INDEX_FOR_SKIP_SCAN);
     if (table->reginfo.not_exists_optimize)
       eta->push_extra(ET_NOT_EXISTS);
 
@@ -28789,6 +29133,7 @@ AGGR_OP::prepare_tmp_table()
   JOIN *join= join_tab->join;
   int rc= 0;
 
+  join_tab->tmp_table_param->last_group_positioned= false;
   if (!join_tab->table->is_created())
   {
     if (instantiate_tmp_table(table, join_tab->tmp_table_param->keyinfo,
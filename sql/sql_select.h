@@ -1348,6 +1348,11 @@ class JOIN :public Sql_alloc
     restore_no_rows_in_result() in ::reinit()
   */
   bool no_rows_in_result_called;
+  /*
+    Set once check_cardinality_estimates() has looked at the join, so that
+    a subquery that is executed many times is checked only once
+  */
+  bool cardinality_checked;
 
   /**
     This is set if SQL_CALC_ROWS was calculated by filesort()
@@ -1581,6 +1586,7 @@ class JOIN :public Sql_alloc
     exec_const_cond= 0;
     group_optimized_away= 0;
     no_rows_in_result_called= 0;
+    cardinality_checked= 0;
     positions= best_positions= 0;
     pushdown_query= 0;
     original_join_tab= 0;
@@ -1637,6 +1643,7 @@ class JOIN :public Sql_alloc
   void exec();
 
   void exec_inner();
+  void check_cardinality_estimates();
   bool prepare_result(List<Item> **columns_list);
   int destroy();
   void restore_tmp();
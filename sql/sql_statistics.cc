@@ -2667,12 +2667,16 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   restore_record(table, s->default_values);
 
-  /* Perform a full table scan to collect statistics on 'table's columns */
-  if (!(rc= file->ha_rnd_init(TRUE)))
+  /*
+    Scan the table to collect statistics on 'table's columns. Only the
+    sampled rows are returned, and the engine may skip the others without
+    reading them.
+  */
+  if (!(rc= file->ha_sample_init(sample_fraction)))
   {
     DEBUG_SYNC(table->in_use, "statistics_collection_start");
 
-    while ((rc= file->ha_rnd_next(table->record[0])) != HA_ERR_END_OF_FILE)
+    while ((rc= file->ha_sample_next(table->record[0])) != HA_ERR_END_OF_FILE)
     {
       if (thd->killed)
         break;
@@ -2680,22 +2684,19 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       if (rc)
         break;
 
-      if (thd_rnd(thd) <= sample_fraction)
+      for (field_ptr= table->field; *field_ptr; field_ptr++)
       {
-        for (field_ptr= table->field; *field_ptr; field_ptr++)
-        {
-          table_field= *field_ptr;
-          if (!bitmap_is_set(table->read_set, table_field->field_index))
-            continue;
-          if ((rc= table_field->collected_stats->add()))
-            break;
-        }
-        if (rc)
+        table_field= *field_ptr;
+        if (!bitmap_is_set(table->read_set, table_field->field_index))
+          continue;
+        if ((rc= table_field->collected_stats->add()))
           break;
-        rows++;
       }
+      if (rc)
+        break;
+      rows++;
     }
-    file->ha_rnd_end();
+    file->ha_sample_end();
   }
   rc= (rc == HA_ERR_END_OF_FILE && !thd->killed) ? 0 : 1;
 
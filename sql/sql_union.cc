@@ -2510,12 +2510,15 @@ bool st_select_lex_unit::exec_recursive()
   else
     with_element->level++;
 
+  /* Pass the new rows to all recursive references with one scan */
+  saved_error=
+    incr_table->insert_all_rows_into_tmp_tables(thd,
+                                                with_element->rec_result->
+                                                  rec_tables,
+                                                tmp_table_param,
+                                                !is_unrestricted);
   while ((rec_table= li++))
   {
-    saved_error=
-      incr_table->insert_all_rows_into_tmp_table(thd, rec_table,
-                                                 tmp_table_param,
-                                                 !is_unrestricted);
     if (!with_element->rec_result->first_rec_table_to_update)
       with_element->rec_result->first_rec_table_to_update= rec_table;
     if (with_element->level == 1 && rec_table->reginfo.join_tab)
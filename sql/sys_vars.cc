@@ -2643,6 +2643,14 @@ static Sys_var_ulong Sys_optimizer_prune_level(
        SESSION_VAR(optimizer_prune_level), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 1), DEFAULT(1), BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_optimizer_reuse_join_order(
+       "optimizer_reuse_join_order",
+       "Let prepared statements and statements of stored programs reuse "
+       "the join order found by their first execution instead of searching "
+       "for it again, as long as the same tables are left to be joined",
+       SESSION_VAR(optimizer_reuse_join_order), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_optimizer_selectivity_sampling_limit(
        "optimizer_selectivity_sampling_limit",
        "Controls number of record samples to check condition selectivity",
@@ -2714,6 +2722,7 @@ export const char *optimizer_switch_names[]=
   "rowid_filter",
   "condition_pushdown_from_having",
   "not_null_range_scan",
+  "skip_scan",
   "default", 
   NullS
 };
@@ -2961,6 +2970,15 @@ static Sys_var_ulong Sys_query_prealloc_size(
        BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_thd_mem_root));
 
+static Sys_var_ulong Sys_query_alloc_keep_size(
+       "query_alloc_keep_size",
+       "Memory, in addition to query_prealloc_size, that is kept allocated "
+       "between statements for query parsing and execution. Statements that "
+       "need more than query_prealloc_size can then reuse it instead of "
+       "allocating and freeing it again",
+       SESSION_VAR(query_alloc_keep_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
 
 // this has to be NO_CMD_LINE as the command-line option has a different name
 static Sys_var_mybool Sys_skip_external_locking(
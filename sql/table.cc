@@ -9007,52 +9007,97 @@ bool TABLE::insert_all_rows_into_tmp_table(THD *thd,
                                            TABLE *tmp_table,
                                            TMP_TABLE_PARAM *tmp_table_param,
                                            bool with_cleanup)
+{
+  List<TABLE> tmp_tables;
+  if (tmp_tables.push_back(tmp_table, thd->mem_root))
+    return true;
+  return insert_all_rows_into_tmp_tables(thd, tmp_tables, tmp_table_param,
+                                         with_cleanup);
+}
+
+
+/*
+  @brief
+    Copy all rows of this table into every table of tmp_tables
+
+  @details
+    The rows are read with one scan of this table and written into each
+    of the tables, which must have the same record format as this one.
+    This is how the new rows of an iteration of a recursive CTE are
+    passed to all its recursive references.
+
+  @retval false  Ok
+  @retval true   Error
+*/
+
+bool TABLE::insert_all_rows_into_tmp_tables(THD *thd,
+                                            List<TABLE> &tmp_tables,
+                                            TMP_TABLE_PARAM *tmp_table_param,
+                                            bool with_cleanup)
 {
   int write_err= 0;
+  List_iterator_fast<TABLE> li(tmp_tables);
+  TABLE *tmp_table;
+  TABLE *first_tmp_table= tmp_tables.head();
 
-  DBUG_ENTER("TABLE::insert_all_rows_into_tmp_table");
+  DBUG_ENTER("TABLE::insert_all_rows_into_tmp_tables");
 
-  if (with_cleanup)
+  if (!first_tmp_table)
+    DBUG_RETURN(0);
+
+  while ((tmp_table= li++))
   {
-   if ((write_err= tmp_table->file->ha_delete_all_rows()))
+    if (with_cleanup &&
+        (write_err= tmp_table->file->ha_delete_all_rows()))
       goto err;
+    if (file->indexes_are_disabled())
+      tmp_table->file->ha_disable_indexes(HA_KEY_SWITCH_ALL);
   }
-   
-  if (file->indexes_are_disabled())
-    tmp_table->file->ha_disable_indexes(HA_KEY_SWITCH_ALL);
   file->ha_index_or_rnd_end();
 
   if (unlikely(file->ha_rnd_init_with_error(1)))
     DBUG_RETURN(1);
 
-  if (tmp_table->no_rows)
-    tmp_table->file->extra(HA_EXTRA_NO_ROWS);
-  else
+  /* update table->file->stats.records */
+  file->info(HA_STATUS_VARIABLE);
+  li.rewind();
+  while ((tmp_table= li++))
   {
-    /* update table->file->stats.records */
-    file->info(HA_STATUS_VARIABLE);
-    tmp_table->file->ha_start_bulk_insert(file->stats.records);
+    if (tmp_table->no_rows)
+      tmp_table->file->extra(HA_EXTRA_NO_ROWS);
+    else
+      tmp_table->file->ha_start_bulk_insert(file->stats.records);
   }
 
-  while (likely(!file->ha_rnd_next(tmp_table->record[0])))
+  while (likely(!file->ha_rnd_next(first_tmp_table->record[0])))
   {
-    write_err= tmp_table->file->ha_write_tmp_row(tmp_table->record[0]);
-    if (unlikely(write_err))
+    li.rewind();
+    while ((tmp_table= li++))
     {
-      bool is_duplicate;
-      if (tmp_table->file->is_fatal_error(write_err, HA_CHECK_DUP) &&
-          create_internal_tmp_table_from_heap(thd, tmp_table,
-                                              tmp_table_param->start_recinfo, 
-                                              &tmp_table_param->recinfo,
-                                              write_err, 1, &is_duplicate))
-	DBUG_RETURN(1);
-       
-    }  
+      if (tmp_table != first_tmp_table)
+        memcpy(tmp_table->record[0], first_tmp_table->record[0],
+               s->reclength);
+      write_err= tmp_table->file->ha_write_tmp_row(tmp_table->record[0]);
+      if (unlikely(write_err))
+      {
+        bool is_duplicate;
+        if (tmp_table->file->is_fatal_error(write_err, HA_CHECK_DUP) &&
+            create_internal_tmp_table_from_heap(thd, tmp_table,
+                                                tmp_table_param->start_recinfo,
+                                                &tmp_table_param->recinfo,
+                                                write_err, 1, &is_duplicate))
+          DBUG_RETURN(1);
+      }
+    }
     if (unlikely(thd->check_killed()))
       goto err_killed;
   }
-  if (!tmp_table->no_rows && tmp_table->file->ha_end_bulk_insert())
-    goto err;
+  li.rewind();
+  while ((tmp_table= li++))
+  {
+    if (!tmp_table->no_rows && tmp_table->file->ha_end_bulk_insert())
+      goto err;
+  }
   DBUG_RETURN(0);
 
 err:
@@ -1674,6 +1674,10 @@ struct TABLE
                                       TABLE *tmp_table,
                                       TMP_TABLE_PARAM *tmp_table_param,
                                       bool with_cleanup);
+  bool insert_all_rows_into_tmp_tables(THD *thd,
+                                       List<TABLE> &tmp_tables,
+                                       TMP_TABLE_PARAM *tmp_table_param,
+                                       bool with_cleanup);
   int fix_vcol_exprs(THD *thd);
   Field *find_field_by_name(LEX_CSTRING *str) const;
   bool export_structure(THD *thd, class Row_definition_list *defs);
@@ -50,6 +50,9 @@
 #include "lf.h"
 #include "table.h"
 #include "sql_base.h"
+#ifdef HAVE_SCHED_GETCPU
+#include <sched.h>
+#endif
 
 
 /** Configuration. */
@@ -313,6 +316,29 @@ void tc_purge()
 }
 
 
+/**
+  Pick the table cache instance for the current thread.
+
+  Threads running on the same CPU share an instance, so that the number of
+  threads competing for an instance mutex does not exceed the number of CPUs
+  that map to it, no matter how many connections there are. If the CPU is
+  not known, the instance is picked by thread id.
+*/
+
+static uint32_t tc_instance(THD *thd, uint32_t n_instances)
+{
+#ifdef HAVE_SCHED_GETCPU
+  if (n_instances > 1)
+  {
+    int cpu= sched_getcpu();
+    if (cpu >= 0)
+      return (uint32_t) cpu % n_instances;
+  }
+#endif
+  return thd->thread_id % n_instances;
+}
+
+
 /**
   Add new TABLE object to table cache.
 
@@ -332,7 +358,7 @@ void tc_purge()
 void tc_add_table(THD *thd, TABLE *table)
 {
   uint32_t i=
-    thd->thread_id % tc_active_instances.load(std::memory_order_relaxed);
+    tc_instance(thd, tc_active_instances.load(std::memory_order_relaxed));
   TABLE *LRU_table= 0;
   TDC_element *element= table->s->tdc;
 
@@ -386,7 +412,7 @@ void tc_add_table(THD *thd, TABLE *table)
 TABLE *tc_acquire_table(THD *thd, TDC_element *element)
 {
   uint32_t n_instances= tc_active_instances.load(std::memory_order_relaxed);
-  uint32_t i= thd->thread_id % n_instances;
+  uint32_t i= tc_instance(thd, n_instances);
   TABLE *table;
 
   tc[i].lock_and_check_contention(n_instances, i);
@@ -204,6 +204,14 @@ void tp_callback(TP_connection *c)
   /* Set priority */
   c->priority= get_priority(c);
 
+#ifndef _WIN32
+  /*
+    The connection may now stay idle for long, do not keep the Vio read
+    buffer for it. It is allocated again by the next read.
+  */
+  vio_release_read_buffer(thd->net.vio);
+#endif
+
   /* Read next command from client. */
   c->set_io_timeout(thd->get_net_wait_timeout());
   c->state= TP_STATE_IDLE;
@@ -265,6 +273,17 @@ static THD *threadpool_add_connection(CONNECT *connect, TP_connection *c)
     goto end;
 
   c->init_vio(thd->net.vio);
+#ifndef _WIN32
+  /*
+    Read commands through the Vio read buffer. A short command then takes
+    one recv() instead of two (header and body), and commands that arrive
+    together are executed without another round through the poll loop,
+    see has_unread_data(). Authentication is done, so SSL can no longer
+    be started on this connection. The buffer is only held while the
+    connection is active, see tp_callback().
+  */
+  (void) vio_set_buffered_read(thd->net.vio);
+#endif
 
   /*
     Check if THD is ok, as prepare_new_connection_state()
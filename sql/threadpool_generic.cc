@@ -454,12 +454,31 @@ static TP_connection_generic *queue_get(thread_group_t *thread_group)
   DBUG_RETURN(0);
 }
 
+/*
+  Account the time a connection spent in the queue of a group, in the
+  histogram of the group that dequeued it.
+*/
+
+static void count_queue_time(thread_group_t *group, TP_connection_generic *c)
+{
+  ulonglong now= threadpool_exact_stats?microsecond_interval_timer():pool_timer.current_microtime;
+  ulonglong limit= 1000;
+  int i;
+  for (i= 0; i < TP_QUEUE_TIME_BUCKETS - 1; i++, limit*= 10)
+  {
+    if (now < c->enqueue_time + limit)
+      break;
+  }
+  TP_INCREMENT_GROUP_COUNTER(group, queue_times[i]);
+}
+
 static TP_connection_generic* queue_get(thread_group_t* group, operation_origin origin)
 {
   auto ret = queue_get(group);
   if (ret)
   {
     TP_INCREMENT_GROUP_COUNTER(group, dequeues[(int)origin]);
+    count_queue_time(group, ret);
   }
   return ret;
 }
@@ -1134,6 +1153,66 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take a queued connection from another, busy group.
+
+  Connections are assigned to groups by their id, so one group can have
+  a queue of connections waiting for its busy threads, while threads of
+  other groups are idle. An idle worker calls this before it goes to
+  sleep, and takes over the first connection (by priority) queued in
+  another group that has active threads.
+
+  The connection is moved to the group of the worker, the same way
+  change_group() does it, so that wait_begin()/wait_end() and the poll
+  descriptor refer to the group that executes it.
+
+  Other groups are only locked with trylock, as the caller holds the
+  mutex of its own group.
+
+  @param thread_group - group of the current worker, locked
+
+  @return connection, or NULL if there is nothing to take
+*/
+
+static TP_connection_generic *steal_connection(thread_group_t *thread_group)
+{
+  uint count= group_count;
+  uint own= (uint) (thread_group - all_groups);
+  DBUG_ENTER("steal_connection");
+
+  for (uint i= 1; i < count; i++)
+  {
+    thread_group_t *group= &all_groups[(own + i) % count];
+    TP_connection_generic *c= NULL;
+
+    /* Unprotected read, only to avoid locking groups with nothing queued */
+    if (is_queue_empty(group) || mysql_mutex_trylock(&group->mutex))
+      continue;
+    if (!group->shutdown && group->active_thread_count > 0 &&
+        (c= queue_get(group)))
+    {
+      if (c->bound_to_poll_descriptor)
+      {
+        io_poll_disassociate_fd(group->pollfd, c->fd);
+        c->bound_to_poll_descriptor= false;
+      }
+      group->connection_count--;
+    }
+    mysql_mutex_unlock(&group->mutex);
+
+    if (c)
+    {
+      c->thread_group= thread_group;
+      thread_group->connection_count++;
+      TP_INCREMENT_GROUP_COUNTER(thread_group, steals);
+      count_queue_time(thread_group, c);
+      DBUG_RETURN(c);
+    }
+  }
+  DBUG_RETURN(NULL);
+}
+
+
 /**
   Retrieve a connection with pending event.
 
@@ -1214,6 +1293,10 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
       }
     }
 
+    /* Help other groups, before going to sleep */
+    if (!oversubscribed && (connection= steal_connection(thread_group)))
+      break;
+
 
     /* And now, finally sleep */
     current_thread->woken = false; /* wake() sets this to true */
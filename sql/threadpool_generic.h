@@ -116,6 +116,11 @@ enum class operation_origin
   LISTENER
 };
 
+/*
+  Histogram of queueing times: below 1ms, 10ms, 100ms, 1s, and longer.
+*/
+const int TP_QUEUE_TIME_BUCKETS= 5;
+
 struct thread_group_counters_t
 {
   ulonglong thread_creations;
@@ -126,6 +131,9 @@ struct thread_group_counters_t
   ulonglong stalls;
   ulonglong dequeues[2];
   ulonglong polls[2];
+  /* Connections taken from the queues of other groups */
+  ulonglong steals;
+  ulonglong queue_times[TP_QUEUE_TIME_BUCKETS];
 };
 
 struct thread_group_t
@@ -13460,6 +13460,29 @@ ha_innobase::records_in_range(
 	const key_range		*max_key,	/*!< in: range end key val, may
 						also be 0 */
         page_range              *pages)
+{
+	ha_rows	n_rows;
+
+	records_in_ranges(keynr, 1, &min_key, &max_key, &n_rows, pages);
+
+	return(n_rows);
+}
+
+/*********************************************************************//**
+Estimates the number of index records in each of a batch of ranges.
+The index lookup and the search tuples are shared by all the ranges. */
+
+void
+ha_innobase::records_in_ranges(
+/*===========================*/
+	uint			keynr,		/*!< in: index number */
+	uint			n_ranges,	/*!< in: number of ranges */
+	const key_range**	min_keys,	/*!< in: start key value of
+						each range, elements may be 0 */
+	const key_range**	max_keys,	/*!< in: end key value of
+						each range, elements may be 0 */
+	ha_rows*		rows,		/*!< out: estimates */
+	page_range*		pages)		/*!< in/out: range positions */
 {
 	KEY*		key;
 	dict_index_t*	index;
@@ -13470,9 +13493,10 @@ ha_innobase::records_in_range(
 	page_cur_mode_t	mode2;
 	mem_heap_t*	heap;
 
-	DBUG_ENTER("records_in_range");
+	DBUG_ENTER("records_in_ranges");
 
 	ut_a(m_prebuilt->trx == thd_to_trx(ha_thd()));
+	ut_ad(n_ranges > 0);
 
 	m_prebuilt->trx->op_info = "estimating records in index range";
 
@@ -13511,81 +13535,99 @@ ha_innobase::records_in_range(
 	range_end = dtuple_create(heap, key->ext_key_parts);
 	dict_index_copy_types(range_end, index, key->ext_key_parts);
 
-	row_sel_convert_mysql_key_to_innobase(
-		range_start,
-		m_prebuilt->srch_key_val1,
-		m_prebuilt->srch_key_val_len,
-		index,
-		(byte*) (min_key ? min_key->key : (const uchar*) 0),
-		(ulint) (min_key ? min_key->length : 0));
+	for (uint i = 0; i < n_ranges; i++) {
+		const key_range*	min_key = min_keys[i];
+		const key_range*	max_key = max_keys[i];
 
-	DBUG_ASSERT(min_key
-		    ? range_start->n_fields > 0
-		    : range_start->n_fields == 0);
+		row_sel_convert_mysql_key_to_innobase(
+			range_start,
+			m_prebuilt->srch_key_val1,
+			m_prebuilt->srch_key_val_len,
+			index,
+			(byte*) (min_key ? min_key->key : (const uchar*) 0),
+			(ulint) (min_key ? min_key->length : 0));
+
+		DBUG_ASSERT(min_key
+			    ? range_start->n_fields > 0
+			    : range_start->n_fields == 0);
 
-	row_sel_convert_mysql_key_to_innobase(
-		range_end,
-		m_prebuilt->srch_key_val2,
-		m_prebuilt->srch_key_val_len,
-		index,
-		(byte*) (max_key ? max_key->key : (const uchar*) 0),
-		(ulint) (max_key ? max_key->length : 0));
+		row_sel_convert_mysql_key_to_innobase(
+			range_end,
+			m_prebuilt->srch_key_val2,
+			m_prebuilt->srch_key_val_len,
+			index,
+			(byte*) (max_key ? max_key->key : (const uchar*) 0),
+			(ulint) (max_key ? max_key->length : 0));
 
-	DBUG_ASSERT(max_key
-		    ? range_end->n_fields > 0
-		    : range_end->n_fields == 0);
+		DBUG_ASSERT(max_key
+			    ? range_end->n_fields > 0
+			    : range_end->n_fields == 0);
 
-	mode1 = convert_search_mode_to_innobase(
-		min_key ? min_key->flag : HA_READ_KEY_EXACT);
+		mode1 = convert_search_mode_to_innobase(
+			min_key ? min_key->flag : HA_READ_KEY_EXACT);
 
-	mode2 = convert_search_mode_to_innobase(
-		max_key ? max_key->flag : HA_READ_KEY_EXACT);
+		mode2 = convert_search_mode_to_innobase(
+			max_key ? max_key->flag : HA_READ_KEY_EXACT);
 
-	if (mode1 != PAGE_CUR_UNSUPP && mode2 != PAGE_CUR_UNSUPP) {
+		if (mode1 != PAGE_CUR_UNSUPP && mode2 != PAGE_CUR_UNSUPP) {
 
-		if (dict_index_is_spatial(index)) {
-			/*Only min_key used in spatial index. */
-			n_rows = rtr_estimate_n_rows_in_range(
-				index, range_start, mode1);
+			if (dict_index_is_spatial(index)) {
+				/*Only min_key used in spatial index. */
+				n_rows = rtr_estimate_n_rows_in_range(
+					index, range_start, mode1);
+			} else {
+				btr_pos_t tuple1(range_start, mode1,
+						 pages[i].first_page);
+				btr_pos_t tuple2(range_end, mode2,
+						 pages[i].last_page);
+				n_rows = btr_estimate_n_rows_in_range(
+					index, &tuple1, &tuple2);
+				pages[i].first_page = tuple1.page_id.raw();
+				pages[i].last_page = tuple2.page_id.raw();
+			}
 		} else {
-                        btr_pos_t tuple1(range_start, mode1, pages->first_page);
-                        btr_pos_t tuple2(range_end,   mode2, pages->last_page);
-			n_rows = btr_estimate_n_rows_in_range(
-                                 index, &tuple1, &tuple2);
-                        pages->first_page= tuple1.page_id.raw();
-                        pages->last_page=  tuple2.page_id.raw();
+
+			n_rows = HA_POS_ERROR;
 		}
-	} else {
 
-		n_rows = HA_POS_ERROR;
+		DBUG_EXECUTE_IF(
+			"print_btr_estimate_n_rows_in_range_return_value",
+			push_warning_printf(
+				ha_thd(), Sql_condition::WARN_LEVEL_WARN,
+				ER_NO_DEFAULT,
+				"btr_estimate_n_rows_in_range(): %lld",
+				(longlong) n_rows);
+		);
+
+		/* The MySQL optimizer seems to believe an estimate of 0 rows
+		is always accurate and may return the result 'Empty set' based
+		on that. The accuracy is not guaranteed, and even if it were,
+		for a locking read we should anyway perform the search to set
+		the next-key lock. Add 1 to the value to make sure MySQL does
+		not make the assumption! */
+
+		rows[i] = n_rows == 0 ? 1 : n_rows;
+
+		if (n_rows == HA_POS_ERROR) {
+			break;
+		}
 	}
 
 	mem_heap_free(heap);
 
-	DBUG_EXECUTE_IF(
-		"print_btr_estimate_n_rows_in_range_return_value",
-		push_warning_printf(
-			ha_thd(), Sql_condition::WARN_LEVEL_WARN,
-			ER_NO_DEFAULT,
-			"btr_estimate_n_rows_in_range(): %lld",
-                        (longlong) n_rows);
-	);
+	m_prebuilt->trx->op_info = (char*)"";
+
+	DBUG_VOID_RETURN;
 
 func_exit:
 
 	m_prebuilt->trx->op_info = (char*)"";
 
-	/* The MySQL optimizer seems to believe an estimate of 0 rows is
-	always accurate and may return the result 'Empty set' based on that.
-	The accuracy is not guaranteed, and even if it were, for a locking
-	read we should anyway perform the search to set the next-key lock.
-	Add 1 to the value to make sure MySQL does not make the assumption! */
-
-	if (n_rows == 0) {
-		n_rows = 1;
+	for (uint i = 0; i < n_ranges; i++) {
+		rows[i] = n_rows;
 	}
 
-	DBUG_RETURN((ha_rows) n_rows);
+	DBUG_VOID_RETURN;
 }
 
 /*********************************************************************//**
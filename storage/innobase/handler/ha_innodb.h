@@ -184,6 +184,14 @@ class ha_innobase final : public handler
                 const key_range*        max_key,
                 page_range*             pages) override;
 
+	void records_in_ranges(
+		uint			inx,
+		uint			n_ranges,
+		const key_range**	min_keys,
+		const key_range**	max_keys,
+		ha_rows*		rows,
+		page_range*		pages) override;
+
 	ha_rows estimate_rows_upper_bound() override;
 
 	void update_create_info(HA_CREATE_INFO* create_info) override;
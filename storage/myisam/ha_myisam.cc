@@ -726,7 +726,7 @@ ha_myisam::ha_myisam(handlerton *hton, TABLE_SHARE *table_arg)
                   HA_CAN_INSERT_DELAYED | HA_CAN_BIT_FIELD | HA_CAN_RTREEKEYS |
                   HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT | HA_CAN_REPAIR |
                   HA_CAN_TABLES_WITHOUT_ROLLBACK),
-   can_enable_indexes(0)
+   can_enable_indexes(0), sample_pos(HA_OFFSET_ERROR)
 {}
 
 handler *ha_myisam::clone(const char *name __attribute__((unused)),
@@ -2052,6 +2052,49 @@ int ha_myisam::restart_rnd_next(uchar *buf)
   return rnd_pos(buf, ref);
 }
 
+/*
+  Rows of a table with fixed length rows are at known positions, so the
+  sample scan can jump over the rows that are not in the sample instead of
+  reading them. The distance to the next sampled row of a Bernoulli sample
+  has a geometric distribution.
+*/
+
+int ha_myisam::sample_init(double fraction)
+{
+  if (fraction >= 1.0 ||
+      (file->s->options & (HA_OPTION_PACK_RECORD | HA_OPTION_COMPRESS_RECORD)))
+  {
+    sample_pos= HA_OFFSET_ERROR;
+    return handler::sample_init(fraction);
+  }
+  sample_pos= 0;
+  return mi_reset(file);
+}
+
+int ha_myisam::sample_next(uchar *buf)
+{
+  ulong reclength= file->s->base.pack_reclength;
+  my_off_t pos;
+  double skip;
+
+  if (sample_pos == HA_OFFSET_ERROR)
+    return handler::sample_next(buf);
+  if (sample_pos >= file->state->data_file_length)
+    return HA_ERR_END_OF_FILE;
+
+  /* Number of rows to skip before the next one in the sample */
+  skip= floor(log(1.0 - thd_rnd(table->in_use)) / log(1.0 - sample_fraction));
+  if (skip >= (double) ((file->state->data_file_length - sample_pos) /
+                        reclength))
+  {
+    sample_pos= file->state->data_file_length;
+    return HA_ERR_END_OF_FILE;
+  }
+  pos= sample_pos + (my_off_t) skip * reclength;
+  sample_pos= pos + reclength;
+  return mi_rrnd(file, buf, pos);
+}
+
 int ha_myisam::rnd_pos(uchar *buf, uchar *pos)
 {
   int error=mi_rrnd(file, buf, my_get_ptr(pos,ref_length));
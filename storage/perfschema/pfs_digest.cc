@@ -159,6 +159,25 @@ static uchar *digest_hash_get_key(const uchar *entry, size_t *length,
   result= & digest->m_digest_key;
   return const_cast<uchar*> (reinterpret_cast<const uchar*> (result));
 }
+
+/**
+  Hash function for the digest hash.
+  The MD5 part of the key is already a good hash value,
+  so only the used part of the schema name needs hashing,
+  instead of every byte of @c PFS_digest_key.
+*/
+static my_hash_value_type digest_hash_func(CHARSET_INFO *cs,
+                                           const uchar *key, size_t)
+{
+  const PFS_digest_key *digest_key=
+    reinterpret_cast<const PFS_digest_key*>(key);
+  ulong nr1= uint4korr(digest_key->m_md5);
+  ulong nr2= 4;
+  cs->coll->hash_sort(cs,
+                      reinterpret_cast<const uchar*>(digest_key->m_schema_name),
+                      digest_key->m_schema_name_length, &nr1, &nr2);
+  return (my_hash_value_type) nr1;
+}
 C_MODE_END
 
 
@@ -173,6 +192,7 @@ int init_digest_hash(const PFS_global_param *param)
     lf_hash_init(&digest_hash, sizeof(PFS_statements_digest_stat*),
                  LF_HASH_UNIQUE, 0, 0, digest_hash_get_key,
                  &my_charset_bin);
+    digest_hash.hash_function= digest_hash_func;
     digest_hash_inited= true;
   }
   return 0;
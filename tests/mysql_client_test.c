@@ -21266,6 +21266,87 @@ static void test_cache_metadata()
 }
 
 
+#ifndef EMBEDDED_LIBRARY
+/*
+  Store a command packet with sequence number 0 at pos, return its end
+*/
+static uchar *store_command(uchar *pos, enum enum_server_command command,
+                            const char *arg, size_t arg_length)
+{
+  int3store(pos, arg_length + 1);
+  pos[3]= 0;
+  pos[4]= (uchar) command;
+  memcpy(pos + 5, arg, arg_length);
+  return pos + 5 + arg_length;
+}
+
+
+/*
+  Read the result of a command sent by store_command(), check that it is
+  a single row with the given value
+*/
+static void check_pipelined_result(MYSQL *m, int value)
+{
+  MYSQL_RES *result;
+  MYSQL_ROW row;
+  m->net.pkt_nr= 1;
+  DIE_UNLESS(mysql_read_query_result(m) == 0);
+  result= mysql_store_result(m);
+  mytest(result);
+  DIE_UNLESS(mysql_num_rows(result) == 1);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(atoi(row[0]) == value);
+  mysql_free_result(result);
+}
+
+
+/*
+  Commands that arrive in one write get a reply each, in order, also when
+  the server holds back the replies to send them together
+*/
+static void test_pipelined_commands()
+{
+  MYSQL *m;
+  uchar buff[256], *pos;
+  const uchar no_stmt[4]= {0, 0, 0, 0};
+  ssize_t length;
+  myheader("test_pipelined_commands");
+
+  m= mysql_client_init(NULL);
+  DIE_UNLESS(m);
+  DIE_UNLESS(mysql_real_connect(m, opt_host, opt_user, opt_password,
+                                current_db, opt_port, opt_unix_socket, 0)
+             == m);
+
+  /* Three queries in one write */
+  pos= store_command(buff, COM_QUERY, STRING_WITH_LEN("SELECT 1"));
+  pos= store_command(pos, COM_QUERY, STRING_WITH_LEN("SELECT 2"));
+  pos= store_command(pos, COM_QUERY, STRING_WITH_LEN("SELECT 3"));
+  length= (ssize_t) (pos - buff);
+  DIE_UNLESS(send(mysql_get_socket(m), (char*) buff, length, 0) == length);
+  check_pipelined_result(m, 1);
+  check_pipelined_result(m, 2);
+  check_pipelined_result(m, 3);
+
+  /*
+    A query followed by a command that has no reply: the reply to the
+    query must not wait for another command
+  */
+  pos= store_command(buff, COM_QUERY, STRING_WITH_LEN("SELECT 4"));
+  pos= store_command(pos, COM_STMT_CLOSE, (const char*) no_stmt,
+                     sizeof(no_stmt));
+  length= (ssize_t) (pos - buff);
+  DIE_UNLESS(send(mysql_get_socket(m), (char*) buff, length, 0) == length);
+  check_pipelined_result(m, 4);
+
+  /* The connection is still in sync */
+  DIE_UNLESS(mysql_query(m, "SELECT 5") == 0);
+  mysql_free_result(mysql_store_result(m));
+  mysql_close(m);
+}
+#endif
+
+
 static struct my_tests_st my_tests[]= {
   { "disable_query_logs", disable_query_logs },
   { "test_view_sp_list_fields", test_view_sp_list_fields },
@@ -21566,6 +21647,9 @@ static struct my_tests_st my_tests[]= {
   { "test_mdev20261", test_mdev20261 },
   { "test_execute_direct", test_execute_direct },
   { "test_cache_metadata", test_cache_metadata},
+#ifndef EMBEDDED_LIBRARY
+  { "test_pipelined_commands", test_pipelined_commands },
+#endif
   { 0, 0 }
 };
 
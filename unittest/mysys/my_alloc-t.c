@@ -0,0 +1,141 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <tap.h>
+
+#define ALLOCS 40
+#define ALLOC_SIZE 900
+
+static MEM_ROOT root;
+static USED_MEM *blocks[ALLOCS];
+static uint block_count;
+
+static void fill_root(void)
+{
+  uint i;
+  for (i= 0; i < ALLOCS; i++)
+    memset(alloc_root(&root, ALLOC_SIZE), i, ALLOC_SIZE);
+}
+
+/* Number of blocks, other than the preallocated one, in a block list */
+static uint count_blocks(USED_MEM *list)
+{
+  uint count= 0;
+  for (; list; list= list->next)
+    if (list != root.pre_alloc)
+      count++;
+  return count;
+}
+
+/* Remember the blocks in use, other than the preallocated one */
+static void save_blocks(void)
+{
+  USED_MEM *list;
+  block_count= 0;
+  for (list= root.used; list; list= list->next)
+    if (list != root.pre_alloc)
+      blocks[block_count++]= list;
+}
+
+/* Check that all the blocks of a list were saved by save_blocks() */
+static my_bool saved_blocks(USED_MEM *list)
+{
+  for (; list; list= list->next)
+  {
+    uint i;
+    if (list == root.pre_alloc)
+      continue;
+    for (i= 0; i < block_count && blocks[i] != list; i++)
+    {}
+    if (i == block_count)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/* Check that the free part of the kept blocks is trashed */
+static my_bool trashed_blocks(void)
+{
+  USED_MEM *list;
+  for (list= root.free; list; list= list->next)
+  {
+    char *start= (char*) list + (list->size - list->left);
+#if defined(__SANITIZE_ADDRESS__)
+    if (!__asan_region_is_poisoned(start, list->left))
+      return FALSE;
+#elif defined(TRASH_FREED_MEMORY) && !defined(HAVE_valgrind)
+    size_t i;
+    for (i= 0; i < list->left; i++)
+      if ((uchar) start[i] != 0x8F)
+        return FALSE;
+#else
+    (void) start;
+#endif
+  }
+  return TRUE;
+}
+
+int main(int argc __attribute__((unused)), char *argv[])
+{
+  size_t total= 0, smallest= 0;
+  USED_MEM *list;
+  uint i;
+  MY_INIT(argv[0]);
+
+  plan(9);
+
+  IF_VALGRIND(skip_all("alloc_root() mallocs every object under valgrind"), );
+
+  init_alloc_root(PSI_NOT_INSTRUMENTED, &root, 1024, 1024, MYF(0));
+
+  fill_root();
+  ok(count_blocks(root.used) + count_blocks(root.free) > 1,
+     "Blocks added to the preallocated one");
+  free_root_keep(&root, 0);
+  ok(root.used == NULL && root.free == root.pre_alloc &&
+     root.free->next == NULL, "Nothing kept with keep_size 0");
+
+  fill_root();
+  save_blocks();
+  for (list= root.used; list; list= list->next)
+    if (list != root.pre_alloc)
+      total+= list->size;
+  free_root_keep(&root, total);
+  ok(root.used == NULL && root.free == root.pre_alloc,
+     "The preallocated block is the first free one");
+  ok(count_blocks(root.free) == block_count && saved_blocks(root.free),
+     "All the blocks kept");
+  ok(trashed_blocks(), "The kept blocks are trashed");
+
+  fill_root();
+  ok(count_blocks(root.used) + count_blocks(root.free) == block_count &&
+     saved_blocks(root.used) && saved_blocks(root.free),
+     "The kept blocks are reused");
+
+  for (i= 0; i < block_count; i++)
+    if (!smallest || blocks[i]->size < smallest)
+      smallest= blocks[i]->size;
+  free_root_keep(&root, smallest);
+  ok(count_blocks(root.free) == 1, "Only the blocks that fit are kept");
+  ok(trashed_blocks(), "The kept block is trashed");
+
+  free_root(&root, MYF(0));
+  ok(root.used == NULL && root.free == NULL, "All the blocks freed");
+
+  my_end(0);
+  return exit_status();
+}
@@ -233,6 +233,57 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 }
 
 
+/**
+  Switch a socket-based Vio to buffered reads.
+
+  @remark Data that is read ahead is not visible to the SSL layer, so
+          this must only be used on connections that no longer can
+          switch to SSL, e.g. after authentication.
+
+  @remark The read buffer is allocated by the first read that needs it,
+          and can be freed while the connection is idle with
+          vio_release_read_buffer().
+
+  @param vio    A VIO object, with nothing read ahead.
+
+  @return Return value is zero on success. Otherwise the Vio keeps
+          reading unbuffered.
+*/
+
+my_bool vio_set_buffered_read(Vio *vio)
+{
+  DBUG_ENTER("vio_set_buffered_read");
+#ifdef HAVE_VIO_READ_BUFF
+  if ((vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SOCKET) &&
+      vio->read == vio_read)
+  {
+    vio->read= vio_read_buff;
+    vio->has_data= vio_buff_has_data;
+    DBUG_RETURN(0);
+  }
+#endif
+  DBUG_RETURN(1);
+}
+
+
+/**
+  Free the read buffer of a Vio if nothing is left in it.
+
+  @remark Used for connections that stay idle for a long time, so that
+          they do not hold VIO_READ_BUFFER_SIZE bytes each. The next read
+          allocates the buffer again.
+*/
+
+void vio_release_read_buffer(Vio *vio)
+{
+  if (vio->read_buffer && vio->read_pos == vio->read_end)
+  {
+    my_free(vio->read_buffer);
+    vio->read_buffer= vio->read_pos= vio->read_end= NULL;
+  }
+}
+
+
 /* Create a new VIO for socket or TCP/IP connection. */
 
 Vio *mysql_socket_vio_new(MYSQL_SOCKET mysql_socket, enum enum_vio_type type, uint flags)
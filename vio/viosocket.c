@@ -224,7 +224,11 @@ size_t vio_read_buff(Vio *vio, uchar* buf, size_t size)
       the safest way to handle it is to move to a separate branch.
     */
   }
-  else if (size < VIO_UNBUFFERED_READ_MIN_SIZE)
+  else if (size < VIO_UNBUFFERED_READ_MIN_SIZE &&
+           (vio->read_buffer ||
+            (vio->read_buffer= (char*) my_malloc(key_memory_vio_read_buffer,
+                                                 VIO_READ_BUFFER_SIZE,
+                                                 MYF(0)))))
   {
     rc= vio_read(vio, (uchar*) vio->read_buffer, VIO_READ_BUFFER_SIZE);
     if (rc != 0 && rc != (size_t) -1)